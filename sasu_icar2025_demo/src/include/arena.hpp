@@ -0,0 +1,255 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file arena.hpp
+ * @author HC
+ * @brief 单帧内存池（帧结束整体回收的线性分配器）+ 稳态堆分配审计
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 每个线程一块定长内存（ARENA_CAPACITY，首次使用时malloc一次），分配只移动游标
+ *                  [02] 释放：最后一次分配可回退游标（vector扩容时常见），其余不回收
+ *                  [03] 帧结束reset()：游标归零；仍有未释放的分配说明帧内临时对象被跨帧持有，计为泄漏
+ *                  [04] 容量耗尽：审计终止模式（heapAudit=2）下立即终止，容量即硬上限；
+ *                       其余模式为软上限：退回全局堆并计数（overflows），审计记录模式下稳态帧同时上报
+ *                  [05] 审计：稳态帧处理期间（HeapAudit::Scope）任何operator new调用都上报调用栈，按模式记录或终止
+ *       FrameVector<T>只用于函数内的单帧临时容器；跨帧保存的成员容器继续使用std::vector（clear后容量保留）
+ *       审计只能拦截operator new：cv::Mat像素内存经cv::fastMalloc直接分配，不在审计范围内
+ *       审计的operator new替换定义在heapaudit.hpp，由主程序（icar/replay）各包含一次
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <execinfo.h>
+#include <new>
+#include <unistd.h>
+#include <vector>
+
+#define ARENA_CAPACITY (256 * 1024) // 单线程单帧内存上限（字节）：单帧临时容器合计不得超过，审计终止模式下超出即终止
+
+/**
+ * @brief 堆分配审计
+ *
+ */
+class HeapAudit
+{
+public:
+    /**
+     * @brief 审计模式
+     *
+     */
+    enum Mode
+    {
+        Off = 0, // 关闭
+        Log,     // 记录调用栈
+        Abort    // 记录调用栈并终止
+    };
+
+    static inline Mode mode = Off;       // 审计模式（启动前设置）
+    static inline uint32_t warmup = 100; // 预热帧数：此后进入稳态
+
+    /**
+     * @brief [05] 稳态帧作用域：作用域内本线程的堆分配均上报
+     *
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(uint64_t frame) : armedLast(armed)
+        {
+            armed = mode != Off && frame > warmup;
+            frameCurrent = frame;
+        }
+        ~Scope() { armed = armedLast; }
+
+    private:
+        bool armedLast; // 嵌套前状态
+    };
+
+    /**
+     * @brief operator new钩子（heapaudit.hpp）
+     *
+     */
+    static void onAllocate(size_t size)
+    {
+        if (armed)
+            report("operator new", size);
+    }
+
+    /**
+     * @brief 上报一次稳态堆访问（日志条数受限，终止模式立即终止）
+     *
+     * @param what 访问类型
+     * @param size 字节数
+     */
+    static void report(const char *what, size_t size)
+    {
+        if (!armed)
+            return;
+        armed = false; // 上报期间的分配（backtrace首次加载）不再上报
+        const uint32_t count = ++reports;
+        if (count <= MAX_REPORTS || mode == Abort)
+        {
+            fprintf(stderr, "[HeapAudit] frame %lu: %s (%zu bytes)\n", (unsigned long)frameCurrent, what, size);
+            void *stack[32];
+            const int depth = backtrace(stack, 32);
+            backtrace_symbols_fd(stack + 1, depth - 1, STDERR_FILENO);
+            if (count == MAX_REPORTS && mode != Abort)
+                fprintf(stderr, "[HeapAudit] 上报已达%u条，此后只计数\n", MAX_REPORTS);
+        }
+        if (mode == Abort)
+            abort();
+        armed = true;
+    }
+
+    /**
+     * @brief 累计上报次数
+     *
+     */
+    static uint32_t count(void) { return reports; }
+
+private:
+    static constexpr uint32_t MAX_REPORTS = 32; // 记录模式最大日志条数
+
+    static inline thread_local bool armed = false;        // 本线程处于稳态帧作用域
+    static inline thread_local uint64_t frameCurrent = 0; // 本线程当前帧序号
+    static inline std::atomic<uint32_t> reports{0};       // 累计上报次数
+};
+
+/**
+ * @brief 单帧内存池（线程私有）
+ *
+ */
+class FrameArena
+{
+public:
+    /**
+     * @brief 本线程内存池
+     *
+     */
+    static FrameArena &local(void)
+    {
+        static thread_local FrameArena arena;
+        return arena;
+    }
+
+    /**
+     * @brief [01] 分配
+     *
+     * @param size 字节数
+     * @param align 对齐
+     */
+    void *allocate(size_t size, size_t align)
+    {
+        if (!buffer && !(buffer = (uint8_t *)malloc(ARENA_CAPACITY))) // 不经operator new：不计入审计
+            throw std::bad_alloc();
+        const size_t offset = (used + align - 1) & ~(align - 1);
+        if (offset + size > ARENA_CAPACITY) // [04] 超出上限：终止模式下终止，否则退回全局堆
+        {
+            overflows++;
+            if (HeapAudit::mode == HeapAudit::Abort) // 不区分预热/稳态：上限与帧序号无关
+            {
+                fprintf(stderr, "[FrameArena] overflow: %zu + %zu bytes > %d\n", offset, size, ARENA_CAPACITY);
+                abort();
+            }
+            HeapAudit::report("arena overflow", size);
+            void *p = malloc(size);
+            if (!p)
+                throw std::bad_alloc();
+            return p;
+        }
+        last = offset;
+        used = offset + size;
+        live++;
+        if (used > peak)
+            peak = used;
+        return buffer + offset;
+    }
+
+    /**
+     * @brief [02] 释放
+     *
+     */
+    void deallocate(void *p, size_t size)
+    {
+        uint8_t *ptr = (uint8_t *)p;
+        if (!buffer || ptr < buffer || ptr >= buffer + ARENA_CAPACITY) // 退回全局堆的分配
+        {
+            free(p);
+            return;
+        }
+        live--;
+        if (ptr == buffer + last && last + size == used) // 最后一次分配：回退游标
+            used = last;
+    }
+
+    /**
+     * @brief [03] 帧结束回收
+     *
+     */
+    void reset(void)
+    {
+        if (live)
+        {
+            leaks++;
+            HeapAudit::report("arena live across frame", used);
+        }
+        used = last = 0;
+        live = 0;
+    }
+
+    size_t peak = 0;        // 单帧最大用量（字节）
+    uint64_t overflows = 0; // 超出上限次数
+    uint64_t leaks = 0;     // 跨帧持有次数
+
+private:
+    uint8_t *buffer = nullptr; // 内存块
+    size_t used = 0;           // 游标
+    size_t last = 0;           // 最后一次分配的起点
+    size_t live = 0;           // 未释放的分配数
+
+    FrameArena() = default;
+    ~FrameArena() { free(buffer); }
+};
+
+/**
+ * @brief 单帧内存池分配器（STL容器）
+ *
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &) {}
+
+    T *allocate(size_t n) { return (T *)FrameArena::local().allocate(n * sizeof(T), alignof(T)); }
+    void deallocate(T *p, size_t n) { FrameArena::local().deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &) const { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>; // 单帧临时容器
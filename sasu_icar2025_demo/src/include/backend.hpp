@@ -0,0 +1,730 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file backend.hpp
+ * @author HC
+ * @brief AI推理后端：Edgeboard（PPNC+ONNX） / ONNX Runtime CPU（完整导出模型） / 检测记录回放
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 后端统一输出检测结果行：[类别, 得分, x1, y1, x2, y2]（原图坐标，未经置信度过滤）
+ *                  ppnc   : NNA推理+post.onnx+PPNC NMS（或内置YOLOv3后处理），需编译选项WITH_PPNC
+ *                  onnx   : ONNX Runtime CPU推理完整导出模型[模型路径]/model.onnx（含NMS，输入image/im_shape/scale_factor）
+ *                  replay : 按推理调用顺序回放检测记录文件（BackendRecorder记录），不加载模型
+ *       检测记录文件格式：8字节文件头"ICARDET1"，每帧 uint32行数 + 行数×6个float
+ *       ONNX/回放后端不依赖Edgeboard，可在x86开发机运行与测试完整icar流程
+ */
+
+#include <onnxruntime_cxx_api.h>
+#include <opencv2/opencv.hpp>
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdlib.h>
+#include <unistd.h>
+#include "json.hpp"
+#include "profiler.hpp"
+#include "tensor.hpp"
+#include "yolo.hpp"
+#ifdef WITH_PPNC
+#include "predictor_api.h"
+#endif
+
+#define DETECTION_FILE_MAGIC "ICARDET1" // 检测记录文件头
+
+/**
+ * @brief AI推理后端接口
+ *
+ */
+class Backend
+{
+public:
+    virtual ~Backend() {}
+
+    /**
+     * @brief 推理一帧
+     *
+     * @param img 输入图像（BGR）
+     */
+    virtual void infer(const cv::Mat &img) = 0;
+
+    /**
+     * @brief 最近一次推理的检测结果
+     *
+     * @param rows 结果行数
+     * @return const float* 检测结果行[类别, 得分, x1, y1, x2, y2]（下次推理前有效）
+     */
+    virtual const float *output(int &rows) = 0;
+
+    /**
+     * @brief 根据类型创建推理后端
+     *
+     * @param type 后端类型：ppnc | onnx | replay
+     * @param pathModel 模型路径
+     * @param pathFile 检测记录文件（replay）
+     * @param nativePost 内置后处理（ppnc）
+     */
+    static std::shared_ptr<Backend> create(const std::string &type, const std::string &pathModel, const std::string &pathFile,
+                                           bool nativePost = false);
+
+protected:
+    static constexpr double IMAGE_MEAN[3] = {0.485, 0.456, 0.406}; // 模型输入归一化均值（RGB）
+    static constexpr double IMAGE_STD[3] = {0.229, 0.224, 0.225};  // 模型输入归一化标准差（RGB）
+};
+
+#ifdef WITH_PPNC
+/**
+ * @brief Edgeboard推理：NNA（PPNC）→post.onnx（ONNX Runtime）→NMS（PPNC），或NNA→内置YOLOv3后处理
+ *
+ */
+class BackendPPNC : public Backend
+{
+public:
+    bool nativePost = false; // 后处理：内置YOLOv3解码+NMS（否则post.onnx+PPNC NMS；未加载时始终内置）
+
+    /**
+     * @brief Construct a new BackendPPNC object
+     *
+     * @param pathModel 模型路径
+     * @param nativePost 内置后处理：不加载post.onnx、不生成/加载PPNC NMS
+     */
+    BackendPPNC(const std::string &pathModel, bool nativePost = false) : nativePost(nativePost)
+    {
+        auto start = std::chrono::steady_clock::now();
+        this->timeMark_ = start;
+
+        // 模型初始化
+        this->predictor_nna_ = std::make_shared<PPNCPredictor>("../src/config/config_ppncnna.json");
+        if (!nativePost)
+        {
+            this->predictor_nms_ = std::make_shared<PPNCPredictor>("../src/config/config_ppncnms.json");
+            this->onnx_env_ = Ort::Env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "test");
+            Ort::SessionOptions session_options;
+            session_options.SetIntraOpNumThreads(8);
+            session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+            std::string onnx_model = pathModel + "/post.onnx";
+            this->predictor_onnx_ = std::make_shared<Ort::Session>(this->onnx_env_, onnx_model.c_str(), session_options);
+            startupLog("onnx session");
+        }
+
+        // ONNX模型加载
+        this->onnx_input_names_.first.push_back("im_shape");
+        this->onnx_input_names_.first.push_back("scale_factor");
+        std::string io_paddle = pathModel + "/io_paddle.json";
+        // read io_paddle
+        std::ifstream ifs(io_paddle);
+        nlohmann::json j;
+        ifs >> j;
+        ifs.close();
+        std::vector<std::vector<int64_t>> shapes_head, shapes_out;
+        for (size_t i = 0; i < j.size(); ++i)
+        {
+            if (j[i]["type"] == "INPUT")
+            {
+                assert(j[i]["shape"].size() == 4);
+                this->inputSize = cv::Size(j[i]["shape"][3], j[i]["shape"][2]);
+            }
+            if (j[i]["type"] == "OUTPUT")
+            {
+                assert(j[i]["shape"].size() == 4);
+                this->onnx_input_names_.first.push_back(j[i]["name"]);
+                shapes_head.push_back(j[i]["shape"].get<std::vector<int64_t>>());
+            }
+            if (j[i]["type"] == "post_out")
+            {
+                this->onnx_out_names_.first.push_back(j[i]["name"]);
+                shapes_out.push_back(j[i]["shape"].get<std::vector<int64_t>>());
+            }
+        }
+
+        for (auto &s : this->onnx_input_names_.first)
+        {
+            this->onnx_input_names_.second.push_back(s.c_str());
+        }
+
+        for (auto &s : this->onnx_out_names_.first)
+        {
+            this->onnx_out_names_.second.push_back(s.c_str());
+        }
+        bindTensors(shapes_out); // 输入输出张量一次分配并绑定
+        this->yoloPost = std::make_shared<YoloPost>(shapes_head, inputSize);
+        this->heads_.assign(shapes_head.size(), nullptr);
+        startupLog("io binding");
+        if (!nativePost)
+        {
+            buildNms(pathModel); // 编译生成.so文件（内容未变化时复用缓存）
+            startupLog("nms build");
+        }
+
+        this->predictor_nna_->load();
+        startupLog("nna load");
+        if (!nativePost)
+        {
+            this->predictor_nms_->load();
+            startupLog("nms load");
+        }
+
+        this->timeMark_ = start;
+        startupLog("total");
+    }
+
+    /**
+     * @brief 生成NMS动态库：以nms.tar内容哈希为键缓存，内容未变化时直接复用nms.tar.so
+     *        重新生成时在模型目录下的私有临时目录中解包编译，完成后原子替换
+     *
+     * @param model_dir 模型路径
+     */
+    void buildNms(const std::string &model_dir)
+    {
+        std::string model_file = model_dir + "/nms.tar";
+        std::string final_file = model_file + ".so";
+        std::string hash_file = final_file + ".fnv1a"; // 缓存键：生成.so时nms.tar的哈希
+
+        uint64_t hash = 0;
+        if (!hashFile(model_file, hash))
+        {
+            std::cout << "Error: cannot read file " << model_file << std::endl;
+            exit(-1);
+        }
+        char hash_text[17];
+        snprintf(hash_text, sizeof(hash_text), "%016llx", (unsigned long long)hash);
+
+        std::string hash_cached;
+        std::ifstream ifs(hash_file);
+        ifs >> hash_cached;
+        ifs.close();
+        if (hash_cached == hash_text && access(final_file.c_str(), R_OK) == 0)
+        {
+            std::cout << "nms cache hit: " << hash_text << std::endl;
+            return;
+        }
+
+        char dir_template[] = "nms.XXXXXX";
+        std::string temp_dir = model_dir + "/." + dir_template;
+        if (!mkdtemp(&temp_dir[0]))
+        {
+            std::cout << "Error: cannot create temp dir " << temp_dir << std::endl;
+            exit(-1);
+        }
+        std::string untar_cmd = "tar -xf " + model_file + " -C " + temp_dir + " --no-same-owner";
+        std::string temp_file = temp_dir + "/nms.tar.so";
+        std::string cc_cmd = "g++ -shared -fPIC -o " + temp_file + " " + temp_dir + "/lib0.o " + temp_dir + "/devc.o";
+        int sys_status = 0;
+
+        sys_status = system(untar_cmd.c_str());
+        if (sys_status)
+        {
+            std::cout << "Error: cannot untar file " << model_file << std::endl;
+            removeDir(temp_dir);
+            exit(-1);
+        }
+
+        // create shared
+        sys_status = system(cc_cmd.c_str());
+        if (sys_status || rename(temp_file.c_str(), final_file.c_str()))
+        {
+            std::cout << "Error: compile for " << model_file << std::endl;
+            removeDir(temp_dir);
+            exit(-1);
+        }
+        removeDir(temp_dir);
+
+        std::ofstream ofs(hash_file);
+        ofs << hash_text << std::endl;
+        ofs.close();
+        std::cout << "compile done: " << hash_text << std::endl;
+    }
+
+    /**
+     * @brief 输入输出张量一次分配：NNA输入、ONNX输入/输出、NMS输入均为持久化张量，
+     *        ONNX输出经IoBinding直接写入NMS输入张量（零拷贝）；内置后处理时只分配NNA输入
+     *
+     * @param shapes_out ONNX输出尺寸（post_out：bboxes, scores）
+     */
+    void bindTensors(const std::vector<std::vector<int64_t>> &shapes_out)
+    {
+        this->feeds_nna_ = {{"image", NDTensor({1, 3, inputSize.height, inputSize.width})}};
+        this->tensorImage = this->feeds_nna_.at("image").value();
+
+        this->tensorInput = std::make_shared<TensorInput>(inputSize, IMAGE_MEAN, IMAGE_STD);
+
+        this->im_shape_[0] = inputSize.height;
+        this->im_shape_[1] = inputSize.width;
+        if (!this->predictor_onnx_) // 内置后处理：未加载post.onnx
+            return;
+
+        assert(shapes_out.size() == 2);
+        this->feeds_nms_ = {{"bboxes", NDTensor(shapes_out[0])}, {"scores", NDTensor(shapes_out[1])}};
+
+        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+        this->onnx_binding_ = std::make_shared<Ort::IoBinding>(*this->predictor_onnx_);
+        this->onnx_inputs_.clear();
+        this->onnx_inputs_.push_back(Ort::Value::CreateTensor<float>(
+            memory_info, this->im_shape_, 2, this->shape_2_, 2));
+        this->onnx_inputs_.push_back(Ort::Value::CreateTensor<float>(
+            memory_info, this->scale_factor_, 2, this->shape_2_, 2));
+        for (size_t i = 2; i < this->onnx_input_names_.second.size(); ++i)
+            this->onnx_inputs_.push_back(Ort::Value(nullptr)); // NNA输出：首次推理后绑定
+        this->onnx_nna_bound_.assign(this->onnx_input_names_.second.size() - 2, nullptr);
+        this->onnx_binding_->BindInput(this->onnx_input_names_.second[0], this->onnx_inputs_[0]);
+        this->onnx_binding_->BindInput(this->onnx_input_names_.second[1], this->onnx_inputs_[1]);
+
+        const char *names_nms[2] = {"bboxes", "scores"};
+        this->onnx_outputs_.clear();
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const NDTensor &t = this->feeds_nms_.at(names_nms[i]);
+            int numel = std::accumulate(t.shape.begin(), t.shape.end(), 1, std::multiplies<>());
+            this->onnx_outputs_.push_back(Ort::Value::CreateTensor<float>(
+                memory_info, t.value(), numel, t.shape.data(), t.shape.size()));
+            this->onnx_binding_->BindOutput(this->onnx_out_names_.second[i], this->onnx_outputs_[i]);
+        }
+    }
+
+    /**
+     * @brief 推理：前处理→NNA→后处理
+     *
+     * @param img 输入图像（BGR）
+     */
+    void infer(const cv::Mat &img) override
+    {
+        preprocess(img); // 图像前处理
+        run();           // 模型推理
+    }
+
+    /**
+     * @brief 检测结果：内置后处理输出，或PPNC NMS输出（100行定长，无效行由得分阈值过滤）
+     *
+     */
+    const float *output(int &rows) override
+    {
+        if (nativePost || !this->predictor_nms_)
+        {
+            rows = this->yoloPost->count;
+            return this->yoloPost->output.data();
+        }
+        const NDTensor &res = get_output(0);
+        rows = std::accumulate(res.shape.begin(), res.shape.end(), 1, std::multiplies<int64_t>()) / 6;
+        return res.value();
+    }
+
+    /**
+     * @brief 图像前处理：缩放+通道交换+归一化+CHW单次遍历，直接写入持久化输入张量
+     *
+     * @param frame 输入图像（BGR）
+     */
+    void preprocess(const cv::Mat &frame)
+    {
+        this->scale_factor_[0] = static_cast<float>(inputSize.height) / frame.rows;
+        this->scale_factor_[1] = static_cast<float>(inputSize.width) / frame.cols;
+        ProfileScope profile(PROFILE_PREPROCESS);
+        tensorInput->process(frame, tensorImage);
+    }
+
+    /**
+     * @brief 模型推理：NNA→后处理
+     *
+     */
+    void run()
+    {
+        runNna();
+        runPost();
+    }
+
+    /**
+     * @brief NNA推理（检测头输出）
+     *
+     */
+    void runNna()
+    {
+        ProfileScope profile(PROFILE_NNA);
+        this->predictor_nna_->set_inputs(this->feeds_nna_);
+        const uint64_t start = tracer.enabled() ? Profiler::ticks() : 0;
+        this->predictor_nna_->run(); // 阻塞至NNA完成
+        if (start) // NNA等待耗时曲线
+        {
+            const uint64_t now = Profiler::ticks();
+            tracer.counter("nna wait(ms)", now, profiler.milliseconds(now - start));
+        }
+    }
+
+    /**
+     * @brief 后处理：内置解码+NMS，或ONNX（IoBinding）→PPNC NMS，帧间无内存分配与中间拷贝
+     *
+     */
+    void runPost()
+    {
+        if (nativePost || !this->predictor_onnx_)
+        {
+            ProfileScope profile(PROFILE_NMS);
+            for (size_t i = 0; i < this->heads_.size(); ++i)
+                this->heads_[i] = this->predictor_nna_->get_output(i).value();
+            this->yoloPost->process(this->heads_.data(), this->im_shape_, this->scale_factor_);
+            return;
+        }
+
+        // NNA输出直接作为ONNX输入：仅在输出缓冲区地址变化时（首帧）重新绑定
+        for (size_t i = 0; i < this->onnx_nna_bound_.size(); ++i)
+        {
+            const NDTensor &t = this->predictor_nna_->get_output(i);
+            if (t.value() == this->onnx_nna_bound_[i])
+                continue;
+
+            auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+            int numel = std::accumulate(t.shape.begin(), t.shape.end(), 1, std::multiplies<>());
+            this->onnx_inputs_[i + 2] = Ort::Value::CreateTensor<float>(
+                memory_info, t.value(), numel, t.shape.data(), t.shape.size());
+            this->onnx_binding_->BindInput(this->onnx_input_names_.second[i + 2], this->onnx_inputs_[i + 2]);
+            this->onnx_nna_bound_[i] = t.value();
+        }
+
+        // onnx run：输出写入NMS输入张量
+        {
+            ProfileScope profile(PROFILE_ONNX);
+            this->predictor_onnx_->Run(this->onnx_run_options_, *this->onnx_binding_);
+        }
+
+        // ppnc_nms run
+        ProfileScope profile(PROFILE_NMS);
+        this->predictor_nms_->set_inputs(this->feeds_nms_);
+        this->predictor_nms_->run();
+    }
+
+    const NDTensor &get_output(int index)
+    {
+        return this->predictor_nms_->get_output(index);
+    }
+
+private:
+    std::chrono::steady_clock::time_point timeMark_; // 启动阶段计时
+
+    /**
+     * @brief 启动阶段耗时日志（距上一阶段）
+     *
+     * @param phase 阶段名称
+     */
+    void startupLog(const char *phase)
+    {
+        auto now = std::chrono::steady_clock::now();
+        printf("[BackendPPNC] %s: %.1fms\n", phase, std::chrono::duration<double, std::milli>(now - this->timeMark_).count());
+        this->timeMark_ = now;
+    }
+
+    /**
+     * @brief 文件内容哈希（FNV-1a 64位）
+     *
+     * @param path 文件路径
+     * @param hash 哈希值
+     * @return true 读取成功
+     */
+    static bool hashFile(const std::string &path, uint64_t &hash)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs.is_open())
+            return false;
+
+        hash = 14695981039346656037ull;
+        char buffer[4096];
+        while (ifs.read(buffer, sizeof(buffer)) || ifs.gcount() > 0)
+        {
+            for (std::streamsize i = 0; i < ifs.gcount(); ++i)
+            {
+                hash ^= (uint8_t)buffer[i];
+                hash *= 1099511628211ull;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 删除临时目录（解包与编译产物）
+     *
+     */
+    static void removeDir(const std::string &dir)
+    {
+        std::string rm_cmd = "rm -rf " + dir;
+        if (system(rm_cmd.c_str()))
+            std::cout << "Warning: cannot remove " << dir << std::endl;
+    }
+    // onnx info
+    std::pair<std::vector<std::string>, std::vector<const char *>> onnx_input_names_;
+    std::pair<std::vector<std::string>, std::vector<const char *>> onnx_out_names_;
+    Ort::Env onnx_env_{nullptr}; // 内置后处理时不创建
+    // predictor
+    std::shared_ptr<PPNCPredictor> predictor_nna_;
+    std::shared_ptr<PPNCPredictor> predictor_nms_;
+    std::shared_ptr<Ort::Session> predictor_onnx_;
+    std::shared_ptr<YoloPost> yoloPost;                      // 内置后处理
+    std::vector<const float *> heads_;                       // 内置后处理输入：检测头（NNA输出）
+    // tensor：一次分配，帧间复用
+    cv::Size inputSize = cv::Size(320, 320);                 // 模型输入尺寸
+    std::shared_ptr<TensorInput> tensorInput;                // 模型输入前处理（融合）
+    float *tensorImage = nullptr;                            // 模型输入张量数据（feeds_nna_["image"]）
+    std::unordered_map<std::string, NDTensor> feeds_nna_;    // NNA输入
+    std::unordered_map<std::string, NDTensor> feeds_nms_;    // NMS输入（即ONNX输出）
+    float im_shape_[2] = {0};                                // ONNX输入：im_shape
+    float scale_factor_[2] = {0};                            // ONNX输入：scale_factor
+    int64_t shape_2_[2] = {1, 2};                            // im_shape/scale_factor尺寸
+    std::vector<Ort::Value> onnx_inputs_;                    // ONNX输入张量（绑定）
+    std::vector<Ort::Value> onnx_outputs_;                   // ONNX输出张量（绑定）
+    std::vector<const float *> onnx_nna_bound_;              // 已绑定的NNA输出缓冲区
+    std::shared_ptr<Ort::IoBinding> onnx_binding_;           // ONNX输入输出绑定
+    Ort::RunOptions onnx_run_options_;
+};
+#endif
+
+/**
+ * @brief ONNX Runtime CPU推理：完整导出模型（主干+后处理+NMS）
+ *
+ */
+class BackendOnnx : public Backend
+{
+public:
+    BackendOnnx(const std::string &pathModel)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Ort::SessionOptions options;
+        options.SetIntraOpNumThreads(4);
+        options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        std::string model = pathModel + "/model.onnx";
+        session = std::make_shared<Ort::Session>(env, model.c_str(), options);
+
+        // 输入输出名称，输入尺寸取自image输入（动态尺寸时默认320×320）
+        Ort::AllocatorWithDefaultOptions allocator;
+        for (size_t i = 0; i < session->GetInputCount(); i++)
+        {
+            namesInput.push_back(session->GetInputNameAllocated(i, allocator).get());
+            if (namesInput.back() != "image")
+                continue;
+            std::vector<int64_t> shape = session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+            if (shape.size() == 4 && shape[2] > 0 && shape[3] > 0)
+                sizeInput = cv::Size(shape[3], shape[2]);
+        }
+        for (size_t i = 0; i < session->GetOutputCount(); i++)
+            namesOutput.push_back(session->GetOutputNameAllocated(i, allocator).get());
+        if (!namesOutput.empty()) // 输出尺寸绑定时校验一次：[N, 6]（N动态），逐帧只取元素个数
+        {
+            std::vector<int64_t> shape = session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            outputRows = shape.size() == 2 && shape[1] == 6;
+        }
+        if (!outputRows)
+            std::cout << "Warning: model output is not [N, 6], detections ignored" << std::endl;
+        for (auto &name : namesInput)
+            pointersInput.push_back(name.c_str());
+        for (auto &name : namesOutput)
+            pointersOutput.push_back(name.c_str());
+
+        // 输入张量一次分配：按名称绑定image/im_shape/scale_factor
+        tensorInput = std::make_shared<TensorInput>(sizeInput, IMAGE_MEAN, IMAGE_STD);
+        image.resize(3 * sizeInput.width * sizeInput.height);
+        shapeImage[2] = sizeInput.height;
+        shapeImage[3] = sizeInput.width;
+        imShape[0] = sizeInput.height;
+        imShape[1] = sizeInput.width;
+        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+        for (auto &name : namesInput)
+        {
+            if (name == "image")
+                inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, image.data(), image.size(), shapeImage, 4));
+            else if (name == "im_shape")
+                inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, imShape, 2, shapePair, 2));
+            else if (name == "scale_factor")
+                inputs.push_back(Ort::Value::CreateTensor<float>(memory_info, scaleFactor, 2, shapePair, 2));
+            else
+            {
+                std::cout << "Error: unsupported model input " << name << std::endl;
+                exit(-1);
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        printf("[BackendOnnx] %s: %.1fms\n", model.c_str(), std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    void infer(const cv::Mat &img) override
+    {
+        scaleFactor[0] = static_cast<float>(sizeInput.height) / img.rows;
+        scaleFactor[1] = static_cast<float>(sizeInput.width) / img.cols;
+        {
+            ProfileScope profile(PROFILE_PREPROCESS);
+            tensorInput->process(img, image.data());
+        }
+
+        ProfileScope profile(PROFILE_ONNX); // 完整模型：NMS在图内
+        outputs = session->Run(runOptions, pointersInput.data(), inputs.data(), inputs.size(),
+                               pointersOutput.data(), pointersOutput.size());
+    }
+
+    /**
+     * @brief 检测结果：第1个输出[N, 6]（Paddle multiclass_nms输出格式）
+     *
+     */
+    const float *output(int &rows) override
+    {
+        rows = 0;
+        if (outputs.empty())
+            return nullptr;
+        if (outputRows)
+            rows = outputs[0].GetTensorTypeAndShapeInfo().GetElementCount() / 6;
+        return outputs[0].GetTensorData<float>();
+    }
+
+private:
+    Ort::Env env = Ort::Env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "onnx");
+    std::shared_ptr<Ort::Session> session;    // 推理会话
+    Ort::RunOptions runOptions;               // 推理选项
+    cv::Size sizeInput = cv::Size(320, 320);  // 模型输入尺寸
+    std::shared_ptr<TensorInput> tensorInput; // 模型输入前处理（融合）
+    std::vector<float> image;                 // 输入张量：image
+    float imShape[2] = {0};                   // 输入张量：im_shape
+    float scaleFactor[2] = {0};               // 输入张量：scale_factor
+    int64_t shapeImage[4] = {1, 3, 0, 0};     // image尺寸
+    int64_t shapePair[2] = {1, 2};            // im_shape/scale_factor尺寸
+    std::vector<std::string> namesInput;      // 输入名称
+    std::vector<std::string> namesOutput;     // 输出名称
+    std::vector<const char *> pointersInput;  // 输入名称（Run参数）
+    std::vector<const char *> pointersOutput; // 输出名称（Run参数）
+    std::vector<Ort::Value> inputs;           // 输入张量
+    std::vector<Ort::Value> outputs;          // 输出张量（下次推理前有效）
+    bool outputRows = false;                  // 第1个输出为[N, 6]：行数=元素个数/6
+};
+
+/**
+ * @brief 检测记录回放：按推理调用顺序逐帧输出记录的检测结果
+ *
+ */
+class BackendReplay : public Backend
+{
+public:
+    BackendReplay(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        char magic[8] = {0};
+        if (!file.read(magic, sizeof(magic)) || std::string(magic, 8) != DETECTION_FILE_MAGIC)
+        {
+            std::cout << "Error: invalid detection file " << path << std::endl;
+            exit(-1);
+        }
+
+        // 全部载入内存：回放时无文件读写
+        uint32_t rows = 0;
+        while (file.read((char *)&rows, sizeof(rows)))
+        {
+            offsets.push_back(data.size());
+            data.resize(data.size() + rows * 6);
+            if (!file.read((char *)&data[offsets.back()], rows * 6 * sizeof(float)))
+            {
+                data.resize(offsets.back());
+                offsets.pop_back();
+                break;
+            }
+        }
+        offsets.push_back(data.size());
+        printf("[BackendReplay] %s: %zu frames\n", path.c_str(), offsets.size() - 1);
+    }
+
+    void infer(const cv::Mat &img) override
+    {
+        (void)img;
+        if (index + 1 < offsets.size())
+            index++;
+        else if (!finished)
+        {
+            finished = true;
+            printf("[BackendReplay] finished\n");
+        }
+    }
+
+    /**
+     * @brief 检测结果：当前帧记录（回放结束后为空）
+     *
+     */
+    const float *output(int &rows) override
+    {
+        if (finished || index == 0)
+        {
+            rows = 0;
+            return data.data();
+        }
+        rows = (offsets[index] - offsets[index - 1]) / 6;
+        return data.data() + offsets[index - 1];
+    }
+
+    bool finished = false; // 回放结束
+
+private:
+    std::vector<float> data;     // 全部检测结果行
+    std::vector<size_t> offsets; // 每帧起始位置（末尾为总长度）
+    size_t index = 0;            // 已回放帧数
+};
+
+/**
+ * @brief 检测结果记录：每次推理后追加一帧，供BackendReplay回放
+ *
+ */
+class BackendRecorder
+{
+public:
+    BackendRecorder(const std::string &path) : file(path, std::ios::binary)
+    {
+        if (!file.is_open())
+        {
+            std::cout << "Error: cannot create detection file " << path << std::endl;
+            exit(-1);
+        }
+        file.write(DETECTION_FILE_MAGIC, 8);
+    }
+
+    ~BackendRecorder() { file.close(); }
+
+    /**
+     * @brief 追加一帧检测结果
+     *
+     * @param data 检测结果行
+     * @param rows 行数
+     */
+    void write(const float *data, int rows)
+    {
+        uint32_t count = rows;
+        file.write((const char *)&count, sizeof(count));
+        file.write((const char *)data, rows * 6 * sizeof(float));
+    }
+
+private:
+    std::ofstream file; // 检测记录文件
+};
+
+inline std::shared_ptr<Backend> Backend::create(const std::string &type, const std::string &pathModel, const std::string &pathFile,
+                                                bool nativePost)
+{
+    if (type == "replay")
+        return std::make_shared<BackendReplay>(pathFile);
+    if (type == "onnx")
+        return std::make_shared<BackendOnnx>(pathModel);
+#ifdef WITH_PPNC
+    if (type == "ppnc")
+        return std::make_shared<BackendPPNC>(pathModel, nativePost);
+#endif
+    std::cout << "Error: unsupported backend " << type << std::endl;
+    exit(-1);
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file bezier.hpp
+ * @author HC
+ * @brief 定阶贝塞尔曲线：编译期二项式系数 + 按dt缓存的伯恩斯坦基函数表
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 二项式系数C(n,i)编译期计算（替代每点每个t三次阶乘）
+ *                  [02] 基函数表：首次使用某dt时计算全部采样点的C(n,i)·t^i·(1-t)^(n-i)，按dt缓存（线程私有）
+ *                  [03] 求值：按采样点分块，控制点在外层、采样点在内层连续乘加（编译器自动向量化）
+ *                  [04] 写入调用方容器（clear后resize，容量复用）
+ *       采样点与原Bezier()一致：t从0起累加dt直到超过1（浮点累加误差决定末点是否输出）
+ *       基函数与累加顺序同原实现，输出坐标逐点相同
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+/**
+ * @brief 二项式系数（编译期）
+ *
+ */
+constexpr int binomial(int n, int k)
+{
+    return k == 0 ? 1 : binomial(n, k - 1) * (n - k + 1) / k;
+}
+
+/**
+ * @brief 伯恩斯坦基函数表
+ *
+ * @tparam Degree 曲线阶数（控制点数-1）
+ */
+template <int Degree>
+class BezierBasis
+{
+public:
+    static constexpr int ORDER = Degree + 1;  // 控制点数
+    static constexpr int SAMPLES_MAX = 128;   // 最大采样点数（dt >= 1/127）
+    static constexpr int CACHE_SIZE = 8;      // 缓存的dt个数（全车用到的dt不超过5种）
+    static constexpr std::array<int, ORDER> BINOMIAL = []()
+    {
+        std::array<int, ORDER> c{};
+        for (int i = 0; i < ORDER; i++)
+            c[i] = binomial(Degree, i);
+        return c;
+    }(); // [01] 二项式系数
+
+    double dt = 0;                            // 采样步长
+    int samples = 0;                          // 采样点数
+    alignas(64) double k[ORDER][SAMPLES_MAX]; // 基函数值：k[i][s] = C(n,i)·t^i·(1-t)^(n-i)
+
+    /**
+     * @brief [02] 取dt对应的基函数表（首次使用时计算）
+     *
+     * @return nullptr：采样点数超出上限
+     */
+    static const BezierBasis *get(double dt)
+    {
+        static thread_local BezierBasis cache[CACHE_SIZE];
+        static thread_local int next = 0;
+        for (const BezierBasis &basis : cache)
+            if (basis.samples && basis.dt == dt)
+                return &basis;
+
+        BezierBasis &basis = cache[next]; // 缓存满时轮换替换
+        next = (next + 1) % CACHE_SIZE;
+        return basis.build(dt) ? &basis : nullptr;
+    }
+
+private:
+    /**
+     * @brief 计算基函数表（t的累加方式同原Bezier()）
+     *
+     */
+    bool build(double dt)
+    {
+        this->dt = dt;
+        samples = 0;
+        double t = 0;
+        while (t <= 1)
+        {
+            if (samples == SAMPLES_MAX)
+            {
+                samples = 0;
+                return false;
+            }
+            for (int i = 0; i < ORDER; i++)
+                k[i][samples] = BINOMIAL[i] * pow(t, i) * pow(1 - t, Degree - i);
+            samples++;
+            t += dt;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief 定阶贝塞尔曲线
+ *
+ * @tparam Degree 曲线阶数（控制点数-1）
+ * @param dt 采样步长
+ * @param input 控制点（Degree+1个）
+ * @param output 曲线点集（调用方容器）
+ */
+template <int Degree, typename Input, typename Output>
+void Bezier(double dt, const Input &input, Output &output)
+{
+    constexpr int ORDER = BezierBasis<Degree>::ORDER;
+    constexpr int BLOCK = 32; // 分块采样点数（累加器驻留栈上）
+    assert(input.size() == ORDER);
+
+    output.clear();
+    const BezierBasis<Degree> *basis = BezierBasis<Degree>::get(dt);
+    if (!basis) // dt过小：逐点计算
+    {
+        double t = 0;
+        while (t <= 1)
+        {
+            double sumX = 0.0, sumY = 0.0;
+            for (int i = 0; i < ORDER; i++)
+            {
+                double k = BezierBasis<Degree>::BINOMIAL[i] * pow(t, i) * pow(1 - t, Degree - i);
+                sumX += k * input[i].x;
+                sumY += k * input[i].y;
+            }
+            output.emplace_back();
+            output.back().x = sumX;
+            output.back().y = sumY;
+            t += dt;
+        }
+        return;
+    }
+
+    output.resize(basis->samples);
+    for (int s0 = 0; s0 < basis->samples; s0 += BLOCK) // [03] 分块求值
+    {
+        const int m = std::min(BLOCK, basis->samples - s0);
+        double sumX[BLOCK] = {0}, sumY[BLOCK] = {0};
+        for (int i = 0; i < ORDER; i++)
+        {
+            const double *k = basis->k[i] + s0;
+            const double x = input[i].x, y = input[i].y;
+            for (int j = 0; j < m; j++)
+            {
+                sumX[j] += k[j] * x;
+                sumY[j] += k[j] * y;
+            }
+        }
+        for (int j = 0; j < m; j++) // [04] 截断取整（同原实现赋值给int坐标）
+        {
+            output[s0 + j].x = sumX[j];
+            output[s0 + j].y = sumY[j];
+        }
+    }
+}
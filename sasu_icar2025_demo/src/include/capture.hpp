@@ -0,0 +1,589 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file capture.hpp
+ * @author HC
+ * @brief 图像采集：V4L2内存映射零拷贝采集 / 本地视频替身
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note V4L2采集流程：
+ *                  [01] VIDIOC_S_FMT 设置分辨率与像素格式（YUYV优先，MJPG备选）
+ *                  [02] VIDIOC_REQBUFS 申请驱动缓冲区并mmap映射到用户空间
+ *                  [03] VIDIOC_QBUF 全部缓冲区入队，VIDIOC_STREAMON 开始采集
+ *                  [04] VIDIOC_DQBUF 取出一帧：以cv::Mat视图直接引用驱动内存（不拷贝）
+ *                  [05] 流水线释放该帧后，缓冲区才重新入队（VIDIOC_QBUF）
+ *       测试：设备路径可指向vivid虚拟摄像头（modprobe vivid），或传入视频文件路径使用本地替身（自检：tool/capture.cpp）
+ *       本地替身按设定分辨率缩放输出；文件结束后isOpened()返回false，CaptureLatest采集线程随之结束
+ *       CaptureLatest：独立线程持续取帧，只保留最新一帧，处理耗时超过帧周期时直接丢弃旧帧
+ */
+
+#include "pipeline.hpp"       // 最新值交换槽
+#include "profiler.hpp"       // 时间线追踪
+#include <opencv2/opencv.hpp> // OpenCV终端部署
+#include <linux/videodev2.h>  // V4L2驱动接口
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 采集帧：驱动缓冲区视图 + 时间戳
+ *
+ */
+struct CaptureFrame
+{
+    Mat data;                 // 图像数据视图（V4L2：直接引用驱动缓冲区）
+    uint32_t format = 0;      // 像素格式：V4L2_PIX_FMT_YUYV/MJPEG/BGR24
+    uint32_t bytes = 0;       // 有效数据字节数
+    uint64_t sequence = 0;    // 驱动帧序号（不连续表示驱动丢帧）
+    int64_t timestamp = 0;    // 采集时间戳：us（CLOCK_MONOTONIC）
+    shared_ptr<void> lease;   // 缓冲区占用凭证：最后一个持有者释放后缓冲区归还驱动
+
+    /**
+     * @brief 解码为BGR图像（YUYV颜色转换/MJPG解码，唯一一次像素拷贝）
+     *
+     * @param bgr 输出图像（尺寸不变时复用内存）
+     * @return true 解码成功
+     */
+    bool decode(Mat &bgr) const
+    {
+        if (data.empty())
+            return false;
+
+        switch (format)
+        {
+        case V4L2_PIX_FMT_YUYV:
+            cvtColor(data, bgr, COLOR_YUV2BGR_YUYV);
+            return true;
+        case V4L2_PIX_FMT_MJPEG:
+            imdecode(data, IMREAD_COLOR, &bgr);
+            return !bgr.empty();
+        case V4L2_PIX_FMT_BGR24:
+            if (bgr.data != data.data)
+                bgr = data;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief 释放缓冲区（归还驱动）
+     *
+     */
+    void release(void)
+    {
+        data.release();
+        lease.reset();
+    }
+};
+
+/**
+ * @brief 图像采集接口
+ *
+ */
+class Capture
+{
+public:
+    virtual ~Capture() {}
+
+    /**
+     * @brief 读取一帧（阻塞至新帧到达或超时）
+     *
+     * @param frame 采集帧
+     * @return true 读取成功
+     */
+    virtual bool read(CaptureFrame &frame) = 0;
+    virtual bool isOpened(void) const = 0;
+    virtual void release(void) = 0;
+
+    int width = 0;  // 实际图像宽度
+    int height = 0; // 实际图像高度
+
+    /**
+     * @brief 根据路径创建采集源：/dev/video* 使用V4L2，其余路径视为本地视频/图像序列
+     *
+     */
+    static shared_ptr<Capture> create(const string &path, int width, int height, int fps, int buffers = 6);
+};
+
+/**
+ * @brief V4L2内存映射零拷贝采集
+ *
+ */
+class CaptureV4L2 : public Capture
+{
+public:
+    /**
+     * @brief 打开摄像头并开始采集
+     *
+     * @param device 设备路径：/dev/video0
+     * @param width 图像宽度
+     * @param height 图像高度
+     * @param fps 帧率
+     * @param count 驱动缓冲区个数（需大于流水线中同时在途的帧数）
+     */
+    CaptureV4L2(const string &device, int width, int height, int fps, int count = 6)
+    {
+        device_->fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+        if (device_->fd < 0)
+        {
+            cout << "[Capture] Open " << device << " failed: " << strerror(errno) << endl;
+            return;
+        }
+
+        if (!setup(width, height, fps, count))
+            return;
+
+        for (uint32_t i = 0; i < device_->buffers.size(); i++) // 全部缓冲区入队
+        {
+            if (!device_->enqueue(i))
+                return;
+        }
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (device_->xioctl(VIDIOC_STREAMON, &type) < 0)
+        {
+            cout << "[Capture] VIDIOC_STREAMON failed: " << strerror(errno) << endl;
+            return;
+        }
+        device_->streaming = true;
+    }
+
+    ~CaptureV4L2() { release(); }
+
+    bool isOpened(void) const override { return device_ && device_->streaming; }
+
+    /**
+     * @brief 读取一帧：以Mat视图引用驱动缓冲区，不拷贝图像数据
+     *
+     * @note 帧对象（含其拷贝）全部释放后，缓冲区才重新入队；
+     *       若流水线长期占用全部缓冲区，驱动将无处写入新帧
+     */
+    bool read(CaptureFrame &frame) override
+    {
+        frame.release();
+        if (!isOpened())
+            return false;
+
+        v4l2_buffer buf;
+        while (true)
+        {
+            pollfd pfd = {device_->fd, POLLIN, 0};
+            int ret = poll(&pfd, 1, 1000);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+            {
+                cout << "[Capture] Frame timeout" << endl;
+                return false;
+            }
+
+            memset(&buf, 0, sizeof(buf));
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            if (device_->xioctl(VIDIOC_DQBUF, &buf) == 0)
+                break;
+            if (errno != EAGAIN)
+            {
+                cout << "[Capture] VIDIOC_DQBUF failed: " << strerror(errno) << endl;
+                return false;
+            }
+        }
+
+        void *start = device_->buffers[buf.index].start;
+        frame.format = format;
+        frame.bytes = buf.bytesused;
+        frame.sequence = buf.sequence;
+        frame.timestamp = (int64_t)buf.timestamp.tv_sec * 1000000 + buf.timestamp.tv_usec;
+        if (format == V4L2_PIX_FMT_MJPEG)
+            frame.data = Mat(1, (int)buf.bytesused, CV_8UC1, start);
+        else
+            frame.data = Mat(height, width, CV_8UC2, start, stride);
+
+        // 缓冲区占用凭证：析构时重新入队（可在任意线程释放），并保持设备与映射有效
+        shared_ptr<Device> owner = device_;
+        uint32_t index = buf.index;
+        frame.lease = shared_ptr<void>(start, [owner, index](void *)
+                                       {
+            if (owner->streaming)
+                owner->enqueue(index); });
+        return true;
+    }
+
+    /**
+     * @brief 停止采集：设备与映射在最后一个采集帧释放后关闭
+     *
+     */
+    void release(void) override
+    {
+        if (!device_)
+            return;
+        if (device_->streaming)
+        {
+            device_->streaming = false;
+            v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            device_->xioctl(VIDIOC_STREAMOFF, &type);
+        }
+        device_.reset();
+    }
+
+private:
+    /**
+     * @brief 驱动缓冲区映射
+     *
+     */
+    struct Buffer
+    {
+        void *start = MAP_FAILED;
+        size_t length = 0;
+    };
+
+    /**
+     * @brief 设备句柄与缓冲区映射（由采集帧共享持有）
+     *
+     */
+    struct Device
+    {
+        int fd = -1;
+        vector<Buffer> buffers;        // 驱动缓冲区
+        atomic<bool> streaming{false}; // 采集中
+
+        ~Device()
+        {
+            for (Buffer &buffer : buffers)
+                if (buffer.start != MAP_FAILED)
+                    munmap(buffer.start, buffer.length);
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        int xioctl(unsigned long request, void *arg)
+        {
+            int ret;
+            do
+                ret = ioctl(fd, request, arg);
+            while (ret < 0 && errno == EINTR);
+            return ret;
+        }
+
+        bool enqueue(uint32_t index)
+        {
+            v4l2_buffer buf;
+            memset(&buf, 0, sizeof(buf));
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = index;
+            if (xioctl(VIDIOC_QBUF, &buf) < 0)
+            {
+                cout << "[Capture] VIDIOC_QBUF failed: " << strerror(errno) << endl;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    shared_ptr<Device> device_ = make_shared<Device>(); // 设备
+    uint32_t format = 0;                                // 像素格式
+    size_t stride = 0;                                  // 行字节数
+
+    /**
+     * @brief 设置采集格式并映射驱动缓冲区
+     *
+     */
+    bool setup(int w, int h, int fps, int count)
+    {
+        Device &dev = *device_;
+        v4l2_capability cap;
+        memset(&cap, 0, sizeof(cap));
+        if (dev.xioctl(VIDIOC_QUERYCAP, &cap) < 0)
+        {
+            cout << "[Capture] VIDIOC_QUERYCAP failed: " << strerror(errno) << endl;
+            return false;
+        }
+        uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+        if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING))
+        {
+            cout << "[Capture] Device does not support streaming capture" << endl;
+            return false;
+        }
+
+        // 像素格式：YUYV免解码，驱动不支持时退回MJPG
+        const uint32_t formats[] = {V4L2_PIX_FMT_YUYV, V4L2_PIX_FMT_MJPEG};
+        v4l2_format fmt;
+        for (uint32_t pixel : formats)
+        {
+            memset(&fmt, 0, sizeof(fmt));
+            fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            fmt.fmt.pix.width = w;
+            fmt.fmt.pix.height = h;
+            fmt.fmt.pix.pixelformat = pixel;
+            fmt.fmt.pix.field = V4L2_FIELD_NONE;
+            if (dev.xioctl(VIDIOC_S_FMT, &fmt) == 0 && fmt.fmt.pix.pixelformat == pixel)
+                break;
+        }
+        format = fmt.fmt.pix.pixelformat;
+        if (format != V4L2_PIX_FMT_YUYV && format != V4L2_PIX_FMT_MJPEG)
+        {
+            cout << "[Capture] Unsupported pixel format" << endl;
+            return false;
+        }
+        width = fmt.fmt.pix.width;
+        height = fmt.fmt.pix.height;
+        stride = fmt.fmt.pix.bytesperline ? fmt.fmt.pix.bytesperline : width * 2;
+
+        v4l2_streamparm parm;
+        memset(&parm, 0, sizeof(parm));
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = fps;
+        dev.xioctl(VIDIOC_S_PARM, &parm); // 部分驱动不支持设置帧率
+
+        v4l2_requestbuffers req;
+        memset(&req, 0, sizeof(req));
+        req.count = count;
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if (dev.xioctl(VIDIOC_REQBUFS, &req) < 0 || req.count < 2)
+        {
+            cout << "[Capture] VIDIOC_REQBUFS failed: " << strerror(errno) << endl;
+            return false;
+        }
+
+        if (req.count < (uint32_t)count) // 驱动分配的缓冲区少于申请个数：流水线在途帧可能占满全部缓冲区
+            cout << "[Capture] Warning: " << req.count << "/" << count << " buffers granted" << endl;
+        dev.buffers.resize(req.count);
+        for (uint32_t i = 0; i < req.count; i++)
+        {
+            v4l2_buffer buf;
+            memset(&buf, 0, sizeof(buf));
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (dev.xioctl(VIDIOC_QUERYBUF, &buf) < 0)
+            {
+                cout << "[Capture] VIDIOC_QUERYBUF failed: " << strerror(errno) << endl;
+                return false;
+            }
+            dev.buffers[i].length = buf.length;
+            dev.buffers[i].start = mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, dev.fd, buf.m.offset);
+            if (dev.buffers[i].start == MAP_FAILED)
+            {
+                cout << "[Capture] mmap failed: " << strerror(errno) << endl;
+                return false;
+            }
+        }
+
+        printf("[Capture] V4L2 %dx%d %c%c%c%c | %zu buffers\n", width, height, format & 0xff,
+               (format >> 8) & 0xff, (format >> 16) & 0xff, (format >> 24) & 0xff, dev.buffers.size());
+        return true;
+    }
+};
+
+/**
+ * @brief 本地视频/图像序列替身：与V4L2采集接口一致，用于无摄像头环境测试
+ *
+ */
+class CaptureFile : public Capture
+{
+public:
+    /**
+     * @brief 打开本地视频/图像序列
+     *
+     * @param path 文件路径
+     * @param width 输出图像宽度（与文件尺寸不同时缩放，同V4L2按设定分辨率输出）
+     * @param height 输出图像高度
+     * @param fps 输出帧率（节拍）
+     */
+    CaptureFile(const string &path, int width, int height, int fps)
+        : capture(path), period(fps > 0 ? 1000000 / fps : 0)
+    {
+        this->width = width;
+        this->height = height;
+    }
+
+    bool isOpened(void) const override { return !eof && capture.isOpened(); }
+
+    /**
+     * @brief 读取一帧（按设定帧率节拍输出，模拟摄像头）
+     *
+     * @return false 读取失败；文件结束后isOpened()返回false，调用方据此结束采集
+     */
+    bool read(CaptureFrame &frame) override
+    {
+        frame.release();
+        if (!isOpened())
+            return false;
+        int64_t now = clock();
+        if (period > 0 && now < timeNext)
+            usleep(timeNext - now);
+        timeNext = max(now, timeNext) + period;
+
+        Mat img;
+        if (!capture.read(img))
+        {
+            eof = true; // 文件结束
+            cout << "[Capture] End of file: " << sequence << " frames" << endl;
+            return false;
+        }
+        if (img.cols != width || img.rows != height)
+            resize(img, img, Size(width, height));
+        frame.data = img;
+        frame.format = V4L2_PIX_FMT_BGR24;
+        frame.bytes = img.total() * img.elemSize();
+        frame.sequence = sequence++;
+        frame.timestamp = clock();
+        return true;
+    }
+
+    void release(void) override { capture.release(); }
+
+private:
+    VideoCapture capture;  // 本地视频
+    int64_t period;        // 帧周期：us
+    int64_t timeNext = 0;  // 下一帧输出时间：us
+    uint64_t sequence = 0; // 帧序号
+    bool eof = false;      // 文件结束
+
+    static int64_t clock(void)
+    {
+        return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * @brief 最新帧采集：采集线程持续排空驱动队列，读取时总是拿到最新一帧
+ *
+ * @note 处理一帧耗时超过帧周期时，VideoCapture/V4L2会返回驱动中排队已久的旧帧；
+ *       这里由采集线程不断取帧并发布到三缓冲，未被取用的旧帧直接丢弃（缓冲区随即归还驱动）
+ */
+class CaptureLatest : public Capture
+{
+public:
+    CaptureLatest(shared_ptr<Capture> source) : source(source)
+    {
+        width = source->width;
+        height = source->height;
+        if (!source->isOpened())
+            return;
+
+        running = true;
+        threadCapture = thread([this]()
+                               {
+            tracer.thread("v4l2");
+            uint64_t sequence = 0;
+            bool first = true;
+            while (running)
+            {
+                CaptureFrame &frame = slot.back();
+                if (!this->source->read(frame))
+                {
+                    if (!this->source->isOpened()) // 采集源结束（文件结束/设备停止）
+                        break;
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                    continue;
+                }
+                if (!first && frame.sequence > sequence + 1) // 驱动内部丢帧
+                    lost += frame.sequence - sequence - 1;
+                sequence = frame.sequence;
+                first = false;
+                tracer.instant("dequeue", Profiler::ticks(), frame.sequence); // 驱动出队（参数：驱动帧序号）
+                slot.publish();
+            }
+            ended = true; });
+    }
+
+    ~CaptureLatest() { release(); }
+
+    bool isOpened(void) const override { return running && !ended; }
+
+    /**
+     * @brief 读取最新一帧（阻塞至新帧到达或超时）
+     *
+     */
+    bool read(CaptureFrame &frame) override
+    {
+        frame.release();
+        for (int wait = 0; running && wait < 5000; wait++) // 超时：1s
+        {
+            if (slot.consume())
+            {
+                frame = std::move(slot.front()); // 读缓冲不再持有驱动缓冲区
+                return true;
+            }
+            if (ended) // 采集源已结束且无新帧
+                return false;
+            this_thread::sleep_for(chrono::microseconds(200));
+        }
+        return false;
+    }
+
+    /**
+     * @brief 停止采集线程并关闭采集源
+     *
+     */
+    void release(void) override
+    {
+        running = false;
+        if (threadCapture.joinable())
+            threadCapture.join();
+        slot.back().release();
+        slot.front().release();
+        if (slot.consume())
+            slot.front().release();
+        source->release();
+    }
+
+    /**
+     * @brief 累计丢弃帧数：未被取用即被新帧覆盖 + 驱动内部丢帧
+     *
+     */
+    uint64_t dropped(void) const { return slot.dropped() + lost.load(); }
+
+    /**
+     * @brief 累计采集帧数
+     *
+     */
+    uint64_t captured(void) const { return slot.published(); }
+
+private:
+    shared_ptr<Capture> source;       // 采集源
+    TripleBuffer<CaptureFrame> slot;  // 最新帧交换槽
+    thread threadCapture;             // 采集线程
+    atomic<bool> running{false};      // 采集线程运行标志
+    atomic<bool> ended{false};        // 采集源已结束
+    atomic<uint64_t> lost{0};         // 驱动内部丢帧数
+};
+
+inline shared_ptr<Capture> Capture::create(const string &path, int width, int height, int fps, int buffers)
+{
+    if (path.compare(0, 10, "/dev/video") == 0)
+        return make_shared<CaptureV4L2>(path, width, height, fps, buffers);
+    return make_shared<CaptureFile>(path, width, height, fps);
+}
\ No newline at end of file
@@ -21,6 +21,8 @@
  * @copyright Copyright (c) 2025
  *
  */
+#include "arena.hpp"
+#include "bezier.hpp"
 #include "json.hpp"
 #include <fstream>
 #include <iostream>
@@ -120,7 +122,7 @@ struct POINT
  *
  * @param image 需要存储的图像
  */
-void savePicture(Mat &image)
+void savePicture(const Mat &image)
 {
     // 存图
     string name = ".jpg";
@@ -138,7 +140,7 @@ void savePicture(Mat &image)
  * @param arr 输入数据集合
  * @return double
  */
-double average(vector<int> vec)
+double average(const vector<int> &vec)
 {
     if (vec.size() < 1)
         return -1;
@@ -158,7 +160,7 @@ double average(vector<int> vec)
  * @param vec Int集合
  * @return double
  */
-double sigma(vector<int> vec)
+double sigma(const vector<int> &vec)
 {
     if (vec.size() < 1)
         return 0;
@@ -179,7 +181,7 @@ double sigma(vector<int> vec)
  * @param vec
  * @return double
  */
-double sigma(vector<POINT> vec)
+double sigma(const vector<POINT> &vec)
 {
     if (vec.size() < 1)
         return 0;
@@ -217,15 +219,16 @@ int factorial(int x)
 }
 
 /**
- * @brief 贝塞尔曲线
+ * @brief 贝塞尔曲线（输出到调用方容器：成员容器复用容量，或单帧临时容器FrameVector）
  *
  * @param dt
- * @param input
- * @return vector<POINT>
+ * @param input 控制点
+ * @param output 曲线点集
  */
-vector<POINT> Bezier(double dt, vector<POINT> input)
+template <typename Input, typename Output>
+void Bezier(double dt, const Input &input, Output &output)
 {
-    vector<POINT> output;
+    output.clear();
 
     double t = 0;
     while (t <= 1)
@@ -248,6 +251,19 @@ vector<POINT> Bezier(double dt, vector<POINT> input)
         output.push_back(p);
         t += dt;
     }
+}
+
+/**
+ * @brief 贝塞尔曲线
+ *
+ * @param dt
+ * @param input
+ * @return vector<POINT>
+ */
+vector<POINT> Bezier(double dt, const vector<POINT> &input)
+{
+    vector<POINT> output;
+    Bezier(dt, input, output);
     return output;
 }
 
@@ -302,6 +318,7 @@ private:
     bool enable = false;   // 显示窗口使能
     int sizeWindow = 1;    // 窗口数量
     cv::Mat imgShow;       // 窗口图像
+    cv::Mat imgDraw;       // 子窗口绘制缓冲（复用内存）
     bool realShow = false; // 实时更新画面
 public:
     int index = 0;      // 图像序号
@@ -334,7 +351,7 @@ public:
      * @param name 窗口名称
      * @param img 显示图像
      */
-    void setNewWindow(int index, string name, Mat img)
+    void setNewWindow(int index, const string &name, const Mat &img)
     {
         // 数据溢出保护
         if (!enable || index <= 0 || index > sizeWindow)
@@ -343,10 +360,10 @@ public:
         if (img.cols <= 0 || img.rows <= 0)
             return;
 
-        Mat imgDraw = img.clone();
-
-        if (imgDraw.type() == CV_8UC1) // 非RGB类型的图像
-            cvtColor(imgDraw, imgDraw, cv::COLOR_GRAY2BGR);
+        if (img.type() == CV_8UC1) // 非RGB类型的图像
+            cvtColor(img, imgDraw, cv::COLOR_GRAY2BGR);
+        else
+            img.copyTo(imgDraw);
 
         // 图像缩放
         if (imgDraw.cols != COLSIMAGE || imgDraw.rows != ROWSIMAGE)
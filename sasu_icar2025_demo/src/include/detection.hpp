@@ -20,8 +20,6 @@
  * @copyright Copyright (c) 2024
  *
  */
-#include "predictor_api.h"
-#include <onnxruntime_cxx_api.h>
 #include <sys/time.h>
 #include <cstdio>
 #include <functional>
@@ -31,11 +29,14 @@
 #include <algorithm>
 #include <vector>
 #include <chrono>
-#include <unordered_map>
 #include <cstdlib>
 #include <memory>
 #include <stdlib.h>
 #include "common.hpp"
+#include "backend.hpp"
+#include "profiler.hpp"
+#include "propagation.hpp"
+#include "tracker.hpp"
 
 /**
  * @brief 目标检测结果
@@ -44,72 +45,160 @@
 struct PredictResult
 {
     int type;          // ID
-    std::string label; // 标签
     float score;       // 置信度
     int x;             // 坐标
     int y;             // 坐标
     int width;         // 尺寸
     int height;        // 尺寸
+    int id = -1;       // 跟踪ID（未确认为-1）
 };
 
-class Detection
+#define LABEL_CAPACITY 32 // 类别容量（类别出现标志位宽）
+
+/**
+ * @brief 目标检测结果集：按类别分桶 + 类别出现标志
+ *
+ * @note 检测结果按类别升序排列（类别内保持NMS输出顺序），每个类别占一段连续区间，
+ *       场景检测按类别直接取区间，无需遍历全部结果；类别标签名不随结果复制（绘制时按类别查表）
+ */
+class PredictResults
 {
 public:
-    std::vector<PredictResult> results; // AI推理结果
-    float score = 0.5;                  // AI检测置信度
+    /**
+     * @brief 单类别检测结果（连续区间，只读）
+     *
+     */
+    struct Bucket
+    {
+        const PredictResult *first;
+        const PredictResult *last;
+
+        const PredictResult *begin(void) const { return first; }
+        const PredictResult *end(void) const { return last; }
+        size_t size(void) const { return last - first; }
+        bool empty(void) const { return first == last; }
+        const PredictResult &operator[](size_t index) const { return first[index]; }
+    };
+
+    uint32_t mask = 0; // 类别出现标志：bit[类别]
 
     /**
-     * @brief Construct a new Detection object
+     * @brief 类别标志位
      *
-     * @param pathModel
      */
-    Detection(const std::string pathModel)
+    static constexpr uint32_t bit(int type) { return 1u << type; }
+
+    size_t size(void) const { return items.size(); }
+    bool empty(void) const { return items.empty(); }
+    PredictResult &operator[](size_t index) { return items[index]; }
+    const PredictResult &operator[](size_t index) const { return items[index]; }
+    std::vector<PredictResult>::iterator begin(void) { return items.begin(); }
+    std::vector<PredictResult>::iterator end(void) { return items.end(); }
+    std::vector<PredictResult>::const_iterator begin(void) const { return items.begin(); }
+    std::vector<PredictResult>::const_iterator end(void) const { return items.end(); }
+
+    /**
+     * @brief 存在指定类别
+     *
+     */
+    bool has(int type) const { return type >= 0 && type < LABEL_CAPACITY && (mask & bit(type)); }
+
+    /**
+     * @brief 存在标志集合中的任一类别
+     *
+     * @param labels 类别标志集合（bit(类别)按位或）
+     */
+    bool any(uint32_t labels) const { return mask & labels; }
+
+    /**
+     * @brief 指定类别的检测结果
+     *
+     */
+    Bucket bucket(int type) const
     {
-        // 模型初始化
-        this->predictor_nna_ = std::make_shared<PPNCPredictor>("../src/config/config_ppncnna.json");
-        this->predictor_nms_ = std::make_shared<PPNCPredictor>("../src/config/config_ppncnms.json");
-        this->onnx_env_ = Ort::Env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "test");
-        Ort::SessionOptions session_options;
-        session_options.SetIntraOpNumThreads(8);
-        session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
-        std::string onnx_model = pathModel + "/post.onnx";
-        this->predictor_onnx_ = std::make_shared<Ort::Session>(this->onnx_env_, onnx_model.c_str(), session_options);
-
-        // ONNX模型加载
-        this->onnx_input_names_.first.push_back("im_shape");
-        this->onnx_input_names_.first.push_back("scale_factor");
-        std::string io_paddle = pathModel + "/io_paddle.json";
-        // read io_paddle
-        std::ifstream ifs(io_paddle);
-        nlohmann::json j;
-        ifs >> j;
-        ifs.close();
-        for (size_t i = 0; i < j.size(); ++i)
-        {
-            if (j[i]["type"] == "OUTPUT")
-            {
-                assert(j[i]["shape"].size() == 4);
-                this->onnx_input_names_.first.push_back(j[i]["name"]);
-            }
-            if (j[i]["type"] == "post_out")
-            {
-                this->onnx_out_names_.first.push_back(j[i]["name"]);
-            }
-        }
+        if (type < 0 || type >= LABEL_CAPACITY || items.empty())
+            return {nullptr, nullptr};
+        const PredictResult *data = items.data();
+        return {data + offsets[type], data + offsets[type + 1]};
+    }
 
-        for (auto &s : this->onnx_input_names_.first)
+    void clear(void)
+    {
+        items.clear();
+        mask = 0;
+        for (int t = 0; t <= LABEL_CAPACITY; t++)
+            offsets[t] = 0;
+    }
+
+    void push_back(const PredictResult &result) { items.push_back(result); }
+
+    /**
+     * @brief 分桶：按类别稳定排序（插入排序：NMS输出通常已按类别升序，近似O(n)且无内存分配），统计区间与出现标志
+     *
+     */
+    void build(void)
+    {
+        for (size_t i = 1; i < items.size(); i++)
         {
-            this->onnx_input_names_.second.push_back(s.c_str());
+            PredictResult result = items[i];
+            size_t j = i;
+            for (; j > 0 && order(items[j - 1]) > order(result); j--)
+                items[j] = items[j - 1];
+            items[j] = result;
         }
 
-        for (auto &s : this->onnx_out_names_.first)
+        mask = 0;
+        size_t index = 0;
+        for (int t = 0; t <= LABEL_CAPACITY; t++)
         {
-            this->onnx_out_names_.second.push_back(s.c_str());
+            while (index < items.size() && order(items[index]) < t)
+                index++;
+            offsets[t] = index;
+            if (t < LABEL_CAPACITY && index < items.size() && items[index].type == t)
+                mask |= bit(t);
         }
-        buildNms(pathModel); // 编译生成.so文件
+    }
+
+private:
+    std::vector<PredictResult> items;          // 检测结果（类别升序）
+    uint16_t offsets[LABEL_CAPACITY + 1] = {0}; // 类别区间起点：bucket(t) = [offsets[t], offsets[t + 1])
+
+    /**
+     * @brief 排序键：超出类别容量的结果排在最后，不参与分桶
+     *
+     */
+    static int order(const PredictResult &result)
+    {
+        return result.type >= 0 && result.type < LABEL_CAPACITY ? result.type : LABEL_CAPACITY;
+    }
+};
+
+class Detection
+{
+public:
+    PredictResults results;             // AI推理结果（按类别分桶）
+    float score = 0.5;                  // AI检测置信度
+    std::shared_ptr<Backend> backend;   // 推理后端
+    int keyframeMax = 1;                // 关键帧最大间隔：每N帧推理一次，其余帧光流传播检测框（1：逐帧推理）
+    float keyframeDecay = 0.9f;         // 传播帧置信度衰减系数（每帧）
+    bool keyframe = true;               // 当前结果来自AI推理（关键帧）
+    ObjectTracker tracker;              // 多目标跟踪（稳定ID/命中数/速度）
 
-        this->predictor_nna_->load();
-        this->predictor_nms_->load();
+    /**
+     * @brief Construct a new Detection object
+     *
+     * @param pathModel 模型路径
+     * @param type 推理后端：ppnc | onnx | replay
+     * @param pathFile 检测记录文件：replay后端回放；record使能时记录
+     * @param record 记录每帧检测结果
+     * @param nativePost 内置后处理（ppnc：不加载post.onnx与PPNC NMS）
+     */
+    Detection(const std::string pathModel, const std::string type = "ppnc",
+              const std::string pathFile = "", bool record = false, bool nativePost = false)
+    {
+        backend = Backend::create(type, pathModel, pathFile, nativePost);
+        if (record && type != "replay")
+            recorder = std::make_shared<BackendRecorder>(pathFile);
 
         // 模型标签加载
         std::string pathLabels = pathModel + "/label_list.txt";
@@ -133,188 +222,84 @@ public:
     /**
      * @brief AI模型推理
      *
+     * @note 关键帧模式（keyframeMax>1）：上一帧结果先经光流传播到当前帧，
+     *       跟踪成功、置信度未衰减到阈值以下且未到关键帧间隔时，直接使用传播结果；
+     *       关键帧推理结果与传播结果一致时间隔加1（至keyframeMax），不一致或跟踪丢失时间隔复位为1
      */
     void inference(cv::Mat img)
     {
-        auto feeds = preprocess(img, {320, 320}); // 图像前处理
-        run(*feeds);                              // 模型推理
-        render();                                 // 后处理
-    }
-
-    /**
-     * @brief
-     *
-     * @param model_dir
-     */
-    void buildNms(const std::string &model_dir)
-    {
-        std::string model_file = model_dir + "/nms.tar";
-        std::string untar_cmd = "tar -xf " + model_file + " -C . --no-same-owner";
-        std::string final_file = model_file + ".so";
-        std::string cc_cmd = "g++ -shared -fPIC -o " + final_file + " lib0.o devc.o";
-        int sys_status = 0;
-
-        sys_status = system(untar_cmd.c_str());
-        if (sys_status)
+        bool tracked = false;
+        if (keyframeMax > 1)
         {
-            std::cout << "Error: cannot untar file " << model_file << std::endl;
-            exit(-1);
+            bool expired = false;
+            {
+                ProfileScope profile(PROFILE_PROPAGATION);
+                propagation.update(img);
+                tracked = propagate(expired);
+            }
+            if (tracked && !expired && ++passed < interval)
+            {
+                keyframe = false;
+                tracker.update(results, false); // 传播帧：只预测，不作为观测
+                return;
+            }
         }
 
-        // create shared
-        sys_status = system(cc_cmd.c_str());
-        if (sys_status)
+        backend->infer(img); // 模型推理
+        if (recorder)        // 记录检测结果（回放用）
         {
-            std::cout << "Error: compile for " << model_file << std::endl;
-            exit(-1);
+            int rows = 0;
+            const float *data = backend->output(rows);
+            recorder->write(data, rows);
         }
-        std::cout << "compile done." << std::endl;
-    }
+        render(); // 后处理
 
-    void transposeAndCopyToTensor(const Mat &src, NDTensor &dst)
-    {
-        Mat channels[3];
-        split(src, channels);
-        int offset = src.rows * src.cols;
-        auto start = dst.value();
-        for (int i = 0; i < 3; ++i)
+        keyframe = true;
+        if (keyframeMax > 1)
         {
-            std::memcpy(start + i * offset, channels[i].data,
-                        offset * sizeof(float));
-        }
-    }
-
-    std::shared_ptr<std::unordered_map<std::string, NDTensor>> preprocess(
-        cv::Mat frame,
-        const std::vector<int64_t> &input_size)
-    {
-        cv::Mat x;
-        NDTensor scale_factor({1, 2}), img({1, 3, input_size[0], input_size[1]});
-        scale_factor.value()[0] = static_cast<float>(input_size[0]) / frame.size[0];
-        scale_factor.value()[1] = static_cast<float>(input_size[1]) / frame.size[1];
-        NDTensor im_shape({1, 2});
-        im_shape.value()[0] = input_size[0];
-        im_shape.value()[1] = input_size[1];
-        cv::cvtColor(frame, x, cv::COLOR_BGR2RGB);
-        cv::resize(x, x, cv::Size(input_size[0], input_size[1]), 0, 0, 2);
-        x.convertTo(x, CV_32FC3);
-        x *= 1 / 255.0;
-        cv::subtract(x, cv::Scalar(0.485, 0.456, 0.406), x);
-        cv::multiply(x, cv::Scalar(1 / 0.229, 1 / 0.224, 1 / 0.225), x);
-        transposeAndCopyToTensor(x, img);
-
-        std::unordered_map<std::string, NDTensor> ret = {
-            {"image", img}, {"im_shape", im_shape}, {"scale_factor", scale_factor}};
-
-        return std::make_shared<std::unordered_map<std::string, NDTensor>>(ret);
-    }
-
-    void run(const std::unordered_map<std::string, NDTensor> &feeds)
-    {
-        auto &image = feeds.at("image");
-        this->predictor_nna_->set_inputs({{"image", image}});
-
-        // ppnc_nna run
-        this->predictor_nna_->run();
-
-        auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
-        std::vector<Ort::Value> input_tensors;
-        NDTensor im_shape = feeds.at("im_shape");
-        NDTensor scale_factor = feeds.at("scale_factor");
-
-        int numel = std::accumulate(im_shape.shape.begin(), im_shape.shape.end(), 1, std::multiplies<>());
-        input_tensors.push_back(Ort::Value::CreateTensor<float>(
-            memory_info,
-            im_shape.value(),
-            numel,
-            im_shape.shape.data(),
-            im_shape.shape.size()));
-        numel = std::accumulate(scale_factor.shape.begin(), scale_factor.shape.end(), 1, std::multiplies<>());
-        input_tensors.push_back(Ort::Value::CreateTensor<float>(
-            memory_info,
-            scale_factor.value(),
-            numel,
-            scale_factor.shape.data(),
-            scale_factor.shape.size()));
-
-        for (size_t i = 2; i < this->onnx_input_names_.second.size(); ++i)
-        {
-            const NDTensor &t = this->predictor_nna_->get_output(i - 2);
-            numel = std::accumulate(t.shape.begin(), t.shape.end(), 1, std::multiplies<>());
-            input_tensors.push_back(Ort::Value::CreateTensor<float>(
-                memory_info, t.value(), numel, t.shape.data(), t.shape.size()));
+            interval = tracked && consistent() ? std::min(interval + 1, keyframeMax) : 1;
+            passed = 0;
+            boxes.clear();
+            types.clear();
+            for (const PredictResult &result : results)
+            {
+                boxes.emplace_back(result.x, result.y, result.width, result.height);
+                types.push_back(result.type);
+            }
         }
-
-        Ort::RunOptions run_options;
-        auto onnx_out = this->predictor_onnx_->Run(
-            run_options,
-            this->onnx_input_names_.second.data(),
-            input_tensors.data(),
-            input_tensors.size(),
-            this->onnx_out_names_.second.data(),
-            this->onnx_out_names_.second.size());
-
-        auto *data0 = onnx_out[0].GetTensorData<float>();
-        auto *data1 = onnx_out[1].GetTensorData<float>();
-        auto output_shape0 = onnx_out[0].GetTensorTypeAndShapeInfo().GetShape();
-        auto output_shape1 = onnx_out[1].GetTensorTypeAndShapeInfo().GetShape();
-
-        int32_t cls_num, num, box_point;
-        // bbox
-        num = output_shape0[1];
-        box_point = output_shape0[2];
-        cls_num = output_shape1[1];
-
-        NDTensor bboxes({1, num, box_point});
-        NDTensor scores({1, cls_num, num});
-
-        std::memcpy(bboxes.value(), data0, num * box_point * sizeof(float));
-        std::memcpy(scores.value(), data1, cls_num * num * sizeof(float));
-
-        // ppnc_nms run
-        this->predictor_nms_->set_inputs({{"bboxes", bboxes}, {"scores", scores}});
-        this->predictor_nms_->run();
-    }
-
-    NDTensor get_output(int index)
-    {
-        return this->predictor_nms_->get_output(index);
+        tracker.update(results); // 关键帧：观测更新
     }
 
     void render()
     {
-        NDTensor res = get_output(0);
-        auto data = res.value();
-        auto prod = std::accumulate(res.shape.begin(), res.shape.end(), 1,
-                                    std::multiplies<int64_t>());
+        int rows = 0;
+        const float *data = backend->output(rows);
 
         results.clear();
         PredictResult result;
-        for (int i = 0; i < prod; i += 6)
+        for (int i = 0; i < rows * 6; i += 6)
         {
             result.type = data[i];
             result.score = data[i + 1];
-            if (result.score < score) // 阈值
+            if (result.score < score || result.type < 0) // 阈值
             {
                 continue;
             }
 
-            // turnning....
-            if (static_cast<size_t>(result.type) < labels.size())
-                result.label = labels[result.type];
             result.x = data[i + 2];
             result.y = data[i + 3];
             result.width = data[i + 4] - data[i + 2];
             result.height = data[i + 5] - data[i + 3];
             results.push_back(result);
         }
+        results.build();
     }
 
     void drawBox(Mat &img)
     {
         for (size_t i = 0; i < results.size(); i++)
         {
-            PredictResult result = results[i];
+            const PredictResult &result = results[i];
 
             auto score = std::to_string(result.score);
             int pointY = result.y - 20;
@@ -322,7 +307,10 @@ public:
                 pointY = 0;
             cv::Rect rectText(result.x, pointY, result.width, 20);
             cv::rectangle(img, rectText, getCvcolor(result.type), -1);
-            std::string label_name = result.label + " [" + score.substr(0, score.find(".") + 3) + "]";
+            std::string label = static_cast<size_t>(result.type) < labels.size() ? labels[result.type] : std::to_string(result.type);
+            std::string label_name = label + " [" + score.substr(0, score.find(".") + 3) + "]";
+            if (result.id >= 0)
+                label_name += " #" + std::to_string(result.id);
             cv::Rect rect(result.x, result.y, result.width, result.height);
             cv::rectangle(img, rect, getCvcolor(result.type), 1);
             cv::putText(img, label_name, Point(result.x, result.y), cv::FONT_HERSHEY_PLAIN, 1, cv::Scalar(0, 0, 254), 1);
@@ -395,12 +383,57 @@ public:
 
 private:
     std::vector<std::string> labels;
-    // onnx info
-    std::pair<std::vector<std::string>, std::vector<const char *>> onnx_input_names_;
-    std::pair<std::vector<std::string>, std::vector<const char *>> onnx_out_names_;
-    Ort::Env onnx_env_;
-    // predictor
-    std::shared_ptr<PPNCPredictor> predictor_nna_;
-    std::shared_ptr<PPNCPredictor> predictor_nms_;
-    std::shared_ptr<Ort::Session> predictor_onnx_;
+    std::shared_ptr<BackendRecorder> recorder; // 检测结果记录
+    BoxPropagation propagation;                // 检测框帧间传播
+    std::vector<cv::Rect2f> boxes;             // 传播中的检测框（浮点，避免逐帧取整漂移）
+    std::vector<int> types;                    // 传播中的检测框类别
+    std::vector<bool> lost;                    // 传播丢失标志
+    int interval = 1;                          // 当前关键帧间隔（自适应）
+    int passed = 0;                            // 距上一关键帧的帧数
+
+    /**
+     * @brief 检测结果传播到当前帧：平移/缩放检测框，置信度衰减
+     *
+     * @param expired 输出：存在置信度衰减到阈值以下的检测框
+     * @return true 全部检测框跟踪成功
+     */
+    bool propagate(bool &expired)
+    {
+        if (propagation.propagate(boxes, lost) > 0)
+            return false;
+
+        for (size_t i = 0; i < results.size() && i < boxes.size(); i++)
+        {
+            results[i].x = cvRound(boxes[i].x);
+            results[i].y = cvRound(boxes[i].y);
+            results[i].width = cvRound(boxes[i].width);
+            results[i].height = cvRound(boxes[i].height);
+            results[i].score *= keyframeDecay;
+            expired |= results[i].score < score;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 关键帧推理结果与传播结果一致：数量相同，且每个推理框都有同类别、交并比不低于0.5的传播框
+     *
+     */
+    bool consistent() const
+    {
+        if (results.size() != boxes.size())
+            return false;
+        for (const PredictResult &result : results)
+        {
+            const cv::Rect2f box(result.x, result.y, result.width, result.height);
+            bool matched = false;
+            for (size_t i = 0; i < boxes.size() && !matched; i++)
+            {
+                const float inter = (box & boxes[i]).area();
+                matched = types[i] == result.type && inter >= 0.5f * (box.area() + boxes[i].area() - inter);
+            }
+            if (!matched)
+                return false;
+        }
+        return true;
+    }
 };
@@ -0,0 +1,170 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file edges.hpp
+ * @author HC
+ * @brief 赛道边缘点集：定容量结构体数组（SoA）存储，帧循环内无堆内存分配
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 行坐标x、列坐标y、斜率slope分别连续存储，容量固定为EDGE_CAPACITY；
+ *       下标访问返回引用代理（.x/.y/.slope），可隐式转换为POINT，接口与vector<POINT>的常用部分一致
+ *       容量说明：每行至多一个边缘点（ROWSIMAGE），但补线（贝塞尔曲线）会追加在截断后的边缘之后，
+ *       充电停车场/快餐店按列重绘边缘（COLSIMAGE+1个点），因此容量取ROWSIMAGE的2倍
+ *       超出容量的点（push_back/resize）丢弃并计入overflows()，退出时输出，非零说明容量不足
+ */
+
+#include <atomic>
+#include <cstring>
+#include <stddef.h>
+#include <vector>
+#include "common.hpp"
+
+#define EDGE_CAPACITY (ROWSIMAGE * 2) // 边缘点集容量
+
+class EdgePoints
+{
+public:
+    /**
+     * @brief 边缘点引用（可写）
+     *
+     */
+    struct Ref
+    {
+        int &x;       // 行坐标
+        int &y;       // 列坐标
+        float &slope; // 边缘斜率
+
+        operator POINT() const
+        {
+            POINT point(x, y);
+            point.slope = slope;
+            return point;
+        }
+
+        Ref &operator=(const POINT &point)
+        {
+            x = point.x;
+            y = point.y;
+            slope = point.slope;
+            return *this;
+        }
+
+        Ref &operator=(const Ref &ref) { return *this = (POINT)ref; }
+    };
+
+    /**
+     * @brief 边缘点引用（只读）
+     *
+     */
+    struct ConstRef
+    {
+        const int &x;
+        const int &y;
+        const float &slope;
+
+        operator POINT() const
+        {
+            POINT point(x, y);
+            point.slope = slope;
+            return point;
+        }
+    };
+
+    EdgePoints() {};
+    EdgePoints(const EdgePoints &edges) { *this = edges; }
+    EdgePoints(const vector<POINT> &points) { *this = points; }
+
+    Ref operator[](size_t index) { return {xs[index], ys[index], slopes[index]}; }
+    ConstRef operator[](size_t index) const { return {xs[index], ys[index], slopes[index]}; }
+
+    size_t size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+    static constexpr size_t capacity(void) { return EDGE_CAPACITY; }
+    static uint64_t overflows(void) { return overflowCount.load(std::memory_order_relaxed); } // 累计丢弃点数
+    void clear(void) { count = 0; }
+
+    /**
+     * @brief 截断/扩展点集：扩展部分置零（同vector<POINT>::resize），超出容量时截至容量并计数
+     *
+     */
+    void resize(size_t size)
+    {
+        if (size > EDGE_CAPACITY)
+        {
+            overflowCount.fetch_add(size - EDGE_CAPACITY, std::memory_order_relaxed);
+            size = EDGE_CAPACITY;
+        }
+        for (size_t i = count; i < size; i++)
+        {
+            xs[i] = 0;
+            ys[i] = 0;
+            slopes[i] = 0;
+        }
+        count = size;
+    }
+
+    /**
+     * @brief 追加边缘点：容量已满时丢弃并计数
+     *
+     */
+    void push_back(const POINT &point)
+    {
+        if (count >= EDGE_CAPACITY)
+        {
+            overflowCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        xs[count] = point.x;
+        ys[count] = point.y;
+        slopes[count] = point.slope;
+        count++;
+    }
+
+    void emplace_back(int x, int y) { push_back(POINT(x, y)); }
+    void emplace_back(const POINT &point) { push_back(point); }
+
+    template <typename Alloc>
+    EdgePoints &operator=(const vector<POINT, Alloc> &points)
+    {
+        count = 0;
+        for (size_t i = 0; i < points.size(); i++)
+            push_back(points[i]);
+        return *this;
+    }
+
+    /**
+     * @brief 复制：仅复制有效点
+     *
+     */
+    EdgePoints &operator=(const EdgePoints &edges)
+    {
+        if (this == &edges)
+            return *this;
+        count = edges.count;
+        memcpy(xs, edges.xs, count * sizeof(int));
+        memcpy(ys, edges.ys, count * sizeof(int));
+        memcpy(slopes, edges.slopes, count * sizeof(float));
+        return *this;
+    }
+
+private:
+    int xs[EDGE_CAPACITY];       // 行坐标
+    int ys[EDGE_CAPACITY];       // 列坐标
+    float slopes[EDGE_CAPACITY]; // 边缘斜率
+    size_t count = 0;            // 有效点数
+
+    static inline std::atomic<uint64_t> overflowCount{0}; // 超出容量丢弃的点数（所有实例累计）
+};
\ No newline at end of file
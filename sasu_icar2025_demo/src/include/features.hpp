@@ -0,0 +1,227 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file features.hpp
+ * @author HC
+ * @brief 单帧直线特征缓存：边缘图（高斯模糊+Canny）与霍夫线段按参数组惰性计算、帧内复用
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 每帧开始时调用frame()载入二值化图像，全部缓存项失效（保留内存）
+ *                  [02] edges()/lines()按参数组查找本帧缓存：命中直接返回，未命中计算后存入
+ *                  [03] 线段由同参数组的边缘图计算，不同霍夫参数共享同一边缘图
+ *                  [04] 窄带检测使能（houghBand，默认关闭）且霍夫参数限定了线段方向角范围时，
+ *                       使用窄带检测（HoughBand），只在该范围内投票；否则一律cv::HoughLinesP（角度范围由调用方筛选）
+ *       各场景（快餐店/临时停车区/充电停车场）只负责按角度/区域筛选线段，不再各自做模糊+边缘+霍夫
+ *       命中/未命中统计每300帧打印一次（期间有计算时）
+ */
+
+#include <stdint.h>
+#include <cstdio>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "hough.hpp"
+
+class LineFeatures
+{
+public:
+    /**
+     * @brief 边缘参数
+     *
+     */
+    struct EdgeParams
+    {
+        bool blur;     // 3×3高斯模糊预处理
+        double low;    // Canny低阈值
+        double high;   // Canny高阈值
+        int aperture;  // Sobel算子尺寸
+
+        bool operator==(const EdgeParams &p) const
+        {
+            return blur == p.blur && low == p.low && high == p.high && aperture == p.aperture;
+        }
+    };
+
+    /**
+     * @brief 霍夫线段参数（HoughLinesP）
+     *
+     */
+    struct HoughParams
+    {
+        double rho;            // 距离分辨率
+        double theta;          // 角度分辨率
+        int threshold;         // 累加器阈值
+        double minLength;      // 最小线段长度
+        double maxGap;         // 最大间隙
+        double angleMin = -90; // 线段方向角下限（度，atan2(dy, dx)）
+        double angleMax = 90;  // 线段方向角上限（度，默认全部方向；仅houghBand使能时用于窄带投票）
+
+        bool operator==(const HoughParams &p) const
+        {
+            return rho == p.rho && theta == p.theta && threshold == p.threshold &&
+                   minLength == p.minLength && maxGap == p.maxGap &&
+                   angleMin == p.angleMin && angleMax == p.angleMax;
+        }
+    };
+
+    bool houghBand = false; // 窄带霍夫检测使能：限定角度范围时只在范围内投票（线段集合与HoughLinesP不完全一致）
+    uint64_t hits = 0;   // 缓存命中次数（边缘图+线段）
+    uint64_t misses = 0; // 缓存未命中次数（边缘图+线段）
+
+    /**
+     * @brief [01] 载入新一帧图像
+     *
+     * @param image 二值化图像（仅保存地址，不增加引用计数：本帧处理结束前须保持有效且不被修改）
+     */
+    void frame(const cv::Mat &image)
+    {
+        if (frames > 0 && frames % 300 == 0 && misses > missesReported)
+        {
+            printf("[LineFeatures] hit: %lu | miss: %lu\n", (unsigned long)hits, (unsigned long)misses);
+            missesReported = misses;
+        }
+        this->image = &image;
+        frames++;
+    }
+
+    /**
+     * @brief [02] 边缘图
+     *
+     */
+    const cv::Mat &edges(const EdgeParams &params)
+    {
+        return edgeEntry(params).edges;
+    }
+
+    /**
+     * @brief [02] 霍夫线段
+     *
+     */
+    const std::vector<cv::Vec4i> &lines(const EdgeParams &edgeParams, const HoughParams &houghParams)
+    {
+        for (int i = 0; i < lineCount; i++)
+        {
+            LineEntry &entry = lineEntries[i];
+            if (entry.edge == edgeParams && entry.hough == houghParams)
+            {
+                if (entry.frame == frames)
+                {
+                    hits++;
+                    return entry.lines;
+                }
+                return computeLines(entry);
+            }
+        }
+
+        LineEntry &entry = lineEntries[lineCount < ENTRY_MAX ? lineCount++ : oldest(lineEntries, lineCount)];
+        entry.edge = edgeParams;
+        entry.hough = houghParams;
+        return computeLines(entry);
+    }
+
+private:
+    static constexpr int ENTRY_MAX = 8; // 每类缓存的参数组数
+
+    /**
+     * @brief 边缘图缓存项
+     *
+     */
+    struct EdgeEntry
+    {
+        EdgeParams params;
+        uint64_t frame = 0; // 计算所在帧（0：无效）
+        cv::Mat blurred;    // 模糊图像
+        cv::Mat edges;      // 边缘图
+    };
+
+    /**
+     * @brief 线段缓存项
+     *
+     */
+    struct LineEntry
+    {
+        EdgeParams edge;
+        HoughParams hough;
+        uint64_t frame = 0;           // 计算所在帧（0：无效）
+        std::vector<cv::Vec4i> lines; // 线段
+    };
+
+    const cv::Mat *image = nullptr;    // 本帧二值化图像
+    uint64_t frames = 0;               // 帧序号（从1开始）
+    uint64_t missesReported = 0;       // 上次打印时的未命中次数
+    EdgeEntry edgeEntries[ENTRY_MAX];  // 边缘图缓存
+    LineEntry lineEntries[ENTRY_MAX];  // 线段缓存
+    int edgeCount = 0;                 // 边缘图缓存项数
+    int lineCount = 0;                 // 线段缓存项数
+    HoughBand hough;                   // 窄带霍夫检测
+
+    /**
+     * @brief 缓存已满时替换最久未计算的项
+     *
+     */
+    template <typename Entry>
+    static int oldest(const Entry *entries, int count)
+    {
+        int index = 0;
+        for (int i = 1; i < count; i++)
+            if (entries[i].frame < entries[index].frame)
+                index = i;
+        return index;
+    }
+
+    EdgeEntry &edgeEntry(const EdgeParams &params)
+    {
+        EdgeEntry *entry = nullptr;
+        for (int i = 0; i < edgeCount && !entry; i++)
+            if (edgeEntries[i].params == params)
+                entry = &edgeEntries[i];
+        if (entry && entry->frame == frames)
+        {
+            hits++;
+            return *entry;
+        }
+        if (!entry)
+        {
+            entry = &edgeEntries[edgeCount < ENTRY_MAX ? edgeCount++ : oldest(edgeEntries, edgeCount)];
+            entry->params = params;
+        }
+
+        misses++;
+        if (params.blur)
+        {
+            cv::GaussianBlur(*image, entry->blurred, cv::Size(3, 3), 0);
+            cv::Canny(entry->blurred, entry->edges, params.low, params.high, params.aperture);
+        }
+        else
+            cv::Canny(*image, entry->edges, params.low, params.high, params.aperture);
+        entry->frame = frames;
+        return *entry;
+    }
+
+    const std::vector<cv::Vec4i> &computeLines(LineEntry &entry)
+    {
+        const cv::Mat &edges = edgeEntry(entry.edge).edges;
+        const HoughParams &p = entry.hough;
+        misses++;
+        if (!houghBand || p.angleMax - p.angleMin >= 180)
+            cv::HoughLinesP(edges, entry.lines, p.rho, p.theta, p.threshold, p.minLength, p.maxGap);
+        else // [04] 限定角度：窄带检测
+            hough.detect(edges, entry.lines, p.rho, p.theta, p.threshold, cvRound(p.minLength), cvRound(p.maxGap),
+                         p.angleMin, p.angleMax);
+        entry.frame = frames;
+        return entry.lines;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file hough.hpp
+ * @author HC
+ * @brief 限定角度的概率霍夫线段检测（窄带HoughLinesP）：只在关心的方向角范围内投票
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 线段方向角范围（外扩ANGLE_MARGIN）换算为法线角度，只保留范围内的角度分箱
+ *                  [02] 按行收集边缘点，随机顺序（与HoughLinesP相同的随机数序列）逐点投票，只累加带内分箱
+ *                  [03] 带内最大票数达到阈值：沿该方向定点步进，求线段端点（间隙超过lineGap停止）
+ *                  [04] 长度达标的线段输出，并清除其像素、撤销其投票；不达标仅清除像素
+ *       算法流程、定点步进、端点与舍入均与cv::HoughLinesP一致：角度范围覆盖全部方向时输出逐条相同
+ *       限定范围后，带外直线不再参与竞争，其像素留给带内投票，线段集合与全角度检测后再筛选存在差异，
+ *       但差异小于HoughLinesP自身的随机性（换随机种子后筛选结果的差异更大）
+ *       近水平线段（临时停车区/充电停车场）约需全部180个分箱中的50~75个：投票/撤销/累加器清零耗时同比例下降
+ *       缓冲区在对象内复用，帧间无内存分配
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+class HoughBand
+{
+public:
+    /**
+     * @brief 线段检测
+     *
+     * @param edges 边缘图（CV_8UC1）
+     * @param lines 检测结果（端点格式同HoughLinesP）
+     * @param rho 距离分辨率（float：同HoughLinesP内部精度）
+     * @param theta 角度分辨率（float）
+     * @param threshold 累加器阈值
+     * @param lineLength 最小线段长度
+     * @param lineGap 最大间隙
+     * @param angleMin 线段方向角下限（度，atan2(dy, dx)，-90~90）
+     * @param angleMax 线段方向角上限（度）
+     */
+    void detect(const cv::Mat &edges, std::vector<cv::Vec4i> &lines, float rho, float theta, int threshold,
+                int lineLength, int lineGap, double angleMin, double angleMax)
+    {
+        lines.clear();
+        const int width = edges.cols, height = edges.rows;
+        const float irho = 1 / rho;
+
+        // [01] 带内角度分箱：方向角α对应法线角α+90°，按180°周期比较
+        int numangle = cvFloor(CV_PI / theta) + 1;
+        if (numangle > 1 && fabs(CV_PI - (numangle - 1) * theta) < theta / 2)
+            --numangle;
+        numrho = cvRound(((width + height) * 2 + 1) / rho);
+        const double center = (angleMin + angleMax) / 2 + 90;
+        const double half = (angleMax - angleMin) / 2 + ANGLE_MARGIN;
+        trig.clear();
+        for (int n = 0; n < numangle; n++)
+        {
+            double delta = std::fmod(std::fabs(n * theta * 180 / CV_PI - center), 180.0);
+            if (std::min(delta, 180 - delta) > half)
+                continue;
+            trig.push_back((float)(cos((double)n * theta) * irho));
+            trig.push_back((float)(sin((double)n * theta) * irho));
+        }
+        const int bins = trig.size() / 2;
+        accum.assign(bins * numrho, 0);
+
+        // [02] 收集边缘点
+        mask.resize(width * height);
+        points.clear();
+        for (int i = 0; i < height; i++)
+        {
+            const uchar *data = edges.ptr<uchar>(i);
+            uchar *mdata = &mask[i * width];
+            for (int j = 0; j < width; j++)
+            {
+                mdata[j] = data[j] != 0;
+                if (data[j])
+                    points.emplace_back(j, i);
+            }
+        }
+
+        cv::RNG rng((uint64)-1);
+        const int shift = 16;
+        cv::Point lineEnd[2];
+        for (int count = points.size(); count > 0; count--)
+        {
+            const int idx = rng.uniform(0, count);
+            const cv::Point point = points[idx];
+            points[idx] = points[count - 1];
+            if (!mask[point.y * width + point.x]) // 已属于其它线段
+                continue;
+
+            // 投票并求带内最大票数
+            int maxVal = threshold - 1, maxN = -1;
+            int *adata = accum.data();
+            for (int n = 0; n < bins; n++, adata += numrho)
+            {
+                const int val = ++adata[index(point.x, point.y, n)];
+                if (maxVal < val)
+                {
+                    maxVal = val;
+                    maxN = n;
+                }
+            }
+            if (maxN < 0)
+                continue;
+
+            // [03] 沿最可能的直线双向步进（定点16位）
+            const float a = -trig[maxN * 2 + 1], b = trig[maxN * 2];
+            int x0 = point.x, y0 = point.y, dx0, dy0;
+            const bool xflag = fabs(a) > fabs(b);
+            if (xflag)
+            {
+                dx0 = a > 0 ? 1 : -1;
+                dy0 = cvRound(b * (1 << shift) / fabs(a));
+                y0 = (y0 << shift) + (1 << (shift - 1));
+            }
+            else
+            {
+                dy0 = b > 0 ? 1 : -1;
+                dx0 = cvRound(a * (1 << shift) / fabs(b));
+                x0 = (x0 << shift) + (1 << (shift - 1));
+            }
+
+            for (int k = 0; k < 2; k++)
+            {
+                int gap = 0, x = x0, y = y0, dx = k ? -dx0 : dx0, dy = k ? -dy0 : dy0;
+                for (;; x += dx, y += dy)
+                {
+                    const int j1 = xflag ? x : x >> shift, i1 = xflag ? y >> shift : y;
+                    if (j1 < 0 || j1 >= width || i1 < 0 || i1 >= height)
+                        break;
+                    if (mask[i1 * width + j1])
+                    {
+                        gap = 0;
+                        lineEnd[k] = cv::Point(j1, i1);
+                    }
+                    else if (++gap > lineGap)
+                        break;
+                }
+            }
+
+            // [04] 清除线段像素（长度达标时撤销投票）
+            const bool good = std::abs(lineEnd[1].x - lineEnd[0].x) >= lineLength ||
+                              std::abs(lineEnd[1].y - lineEnd[0].y) >= lineLength;
+            for (int k = 0; k < 2; k++)
+            {
+                int x = x0, y = y0, dx = k ? -dx0 : dx0, dy = k ? -dy0 : dy0;
+                for (;; x += dx, y += dy)
+                {
+                    const int j1 = xflag ? x : x >> shift, i1 = xflag ? y >> shift : y;
+                    uchar &m = mask[i1 * width + j1];
+                    if (m)
+                    {
+                        if (good)
+                        {
+                            adata = accum.data();
+                            for (int n = 0; n < bins; n++, adata += numrho)
+                                adata[index(j1, i1, n)]--;
+                        }
+                        m = 0;
+                    }
+                    if (i1 == lineEnd[k].y && j1 == lineEnd[k].x)
+                        break;
+                }
+            }
+
+            if (good)
+                lines.emplace_back(lineEnd[0].x, lineEnd[0].y, lineEnd[1].x, lineEnd[1].y);
+        }
+    }
+
+private:
+    static constexpr double ANGLE_MARGIN = 10; // 角度范围外扩（度）：投票方向与端点连线方向存在偏差
+
+    int numrho = 0;                  // 距离分箱数
+    std::vector<float> trig;         // 带内分箱[cos/rho, sin/rho]
+    std::vector<int> accum;          // 累加器（带内分箱数×距离分箱数）
+    std::vector<uchar> mask;         // 未归属线段的边缘点
+    std::vector<cv::Point> points;   // 待处理边缘点
+
+    /**
+     * @brief 点在第n个带内分箱的距离序号（运算顺序同HoughLinesP）
+     *
+     */
+    int index(int x, int y, int n) const
+    {
+        return cvRound(x * trig[n * 2] + y * trig[n * 2 + 1]) + (numrho - 1) / 2;
+    }
+};
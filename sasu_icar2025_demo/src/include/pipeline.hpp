@@ -0,0 +1,251 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file pipeline.hpp
+ * @author HC
+ * @brief 多线程流水线：单生产者/单消费者无锁环形队列，最新值无锁交换槽
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 流水线各级之间通过有界环形队列连接：
+ *       [采集] → [预处理] → [AI推理] → [识别/控制] → [执行]
+ *       每一级独占一个线程，帧吞吐率由最慢的一级决定，而不是各级耗时之和
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief 单生产者/单消费者无锁环形队列（有界）
+ *
+ * @tparam T 元素类型
+ * @tparam N 队列容量（必须为2的幂）
+ */
+template <typename T, size_t N>
+class RingBuffer
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of 2");
+
+public:
+    /**
+     * @brief 写入元素（仅生产者线程调用）
+     *
+     * @param item 写入的元素
+     * @return true 写入成功
+     * @return false 队列已满
+     */
+    bool push(T &&item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= N) // 队列已满
+            return false;
+
+        buffer[head & (N - 1)] = std::move(item);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 读取元素（仅消费者线程调用）
+     *
+     * @param item 读出的元素
+     * @return true 读取成功
+     * @return false 队列为空
+     */
+    bool pop(T &item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) // 队列为空
+            return false;
+
+        item = std::move(buffer[tail & (N - 1)]); // 移出后槽位不再持有图像内存
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 阻塞写入：队列满时等待下一级消费
+     *
+     * @param item 写入的元素
+     * @param running 流水线运行标志
+     * @return false 流水线已停止
+     */
+    bool pushWait(T &&item, const std::atomic<bool> &running)
+    {
+        for (uint32_t spin = 0; !push(std::move(item)); spin++)
+        {
+            if (!running.load(std::memory_order_relaxed))
+                return false;
+            backoff(spin);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 阻塞读取：队列空时等待上一级生产
+     *
+     * @param item 读出的元素
+     * @param running 流水线运行标志
+     * @return false 流水线已停止
+     */
+    bool popWait(T &item, const std::atomic<bool> &running)
+    {
+        for (uint32_t spin = 0; !pop(item); spin++)
+        {
+            if (!running.load(std::memory_order_relaxed))
+                return false;
+            backoff(spin);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 阻塞读取最新元素：较旧的元素直接丢弃（仅消费者线程调用）
+     *
+     * @note 下一级处理慢于上一级时，队列中积压的是过期帧；取最新一帧，丢弃的帧计入dropped()
+     * @param item 读出的元素
+     * @param running 流水线运行标志
+     * @return false 流水线已停止
+     */
+    bool popLatestWait(T &item, const std::atomic<bool> &running)
+    {
+        if (!popWait(item, running))
+            return false;
+        while (pop(item))
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 累计丢弃的过期元素个数（popLatestWait）
+     *
+     */
+    uint64_t dropped(void) const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 当前队列中的元素个数（近似值）
+     *
+     */
+    size_t size(void) const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity(void) { return N; }
+
+private:
+    alignas(64) std::atomic<size_t> head_{0}; // 写序号（生产者独占写）
+    alignas(64) std::atomic<size_t> tail_{0}; // 读序号（消费者独占写）
+    alignas(64) T buffer[N];                  // 元素存储区
+    std::atomic<uint64_t> dropped_{0};        // 丢弃的过期元素个数（消费者独占写）
+
+    /**
+     * @brief 等待退避：先让出CPU，长时间等待后休眠，避免空转占满核心
+     *
+     * @param spin 已等待次数
+     */
+    static void backoff(uint32_t spin)
+    {
+        if (spin < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+};
+
+/**
+ * @brief 最新值无锁交换槽（三缓冲，单生产者/单消费者）
+ *
+ * @note 生产者始终写入私有的后台缓冲，发布时与中间缓冲原子交换；
+ *       消费者取用时再与中间缓冲交换，只能拿到最新一次发布的数据，旧数据被直接覆盖
+ * @tparam T 元素类型
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief 生产者私有的写缓冲
+     *
+     */
+    T &back(void) { return buffer[indexWrite]; }
+
+    /**
+     * @brief 发布写缓冲中的数据（仅生产者线程调用）
+     *
+     * @return true 上一次发布的数据未被取用，已被覆盖丢弃
+     */
+    bool publish(void)
+    {
+        const uint32_t last = state.exchange(indexWrite | FRESH, std::memory_order_acq_rel);
+        indexWrite = last & INDEX;
+        version.fetch_add(1, std::memory_order_release);
+        if (last & FRESH)
+        {
+            overwritten.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 取用最新发布的数据（仅消费者线程调用）
+     *
+     * @return true 有新数据：通过front()访问
+     * @return false 自上次取用后无新发布
+     */
+    bool consume(void)
+    {
+        if (!(state.load(std::memory_order_acquire) & FRESH))
+            return false;
+
+        const uint32_t last = state.exchange(indexRead, std::memory_order_acq_rel);
+        indexRead = last & INDEX;
+        return true;
+    }
+
+    /**
+     * @brief 消费者私有的读缓冲（最近一次consume取得的数据）
+     *
+     */
+    T &front(void) { return buffer[indexRead]; }
+
+    /**
+     * @brief 累计发布次数
+     *
+     */
+    uint64_t published(void) const { return version.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 累计未被取用即被覆盖的次数（消费者跟不上生产者）
+     *
+     */
+    uint64_t dropped(void) const { return overwritten.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t INDEX = 0x3; // 缓冲序号掩码
+    static constexpr uint32_t FRESH = 0x4; // 中间缓冲存在未取用的新数据
+
+    T buffer[3];                                  // 三缓冲
+    alignas(64) std::atomic<uint32_t> state{2};   // 中间缓冲序号|新数据标志
+    alignas(64) std::atomic<uint64_t> version{0}; // 发布版本号
+    std::atomic<uint64_t> overwritten{0};         // 覆盖丢弃次数
+    alignas(64) uint32_t indexWrite = 0;          // 写缓冲序号（生产者私有）
+    alignas(64) uint32_t indexRead = 1;           // 读缓冲序号（消费者私有）
+};
\ No newline at end of file
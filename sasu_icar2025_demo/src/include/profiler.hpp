@@ -0,0 +1,329 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file profiler.hpp
+ * @author HC
+ * @brief 分阶段耗时统计：单调时钟作用域计时 + 无锁对数直方图（p50/p99/max/超时计数）
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 作用域计时：构造/析构各读一次单调时钟（aarch64直接读通用定时器cntvct_el0，其余平台steady_clock）
+ *                  [02] 耗时写入该阶段直方图：对数分桶（每2倍区间16个子桶，相对误差<6.25%），计数为原子变量，relaxed累加
+ *                  [03] 同时累计总耗时、最大值（CAS），超过该阶段时限时超时计数+1
+ *                  [04] 每帧调用poll()：收到SIGUSR1或到达输出周期时，输出各阶段统计（追加到文件或标准输出）
+ *       统计为启动以来累计值；未使能时作用域计时只有一次分支判断
+ *       直方图定容、无锁，可在任意线程记录（流水线各级线程、串口接收线程）
+ *       时间线追踪（trace.hpp）使能时，作用域计时同时输出阶段区间事件
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <signal.h>
+#include <stdint.h>
+#include <string>
+#include "trace.hpp"
+
+/**
+ * @brief 计时阶段
+ *
+ */
+enum ProfileStage
+{
+    PROFILE_FRAME = 0,   // 整帧：采集→串口下发
+    PROFILE_CAPTURE,     // 图像采集（解码）
+    PROFILE_CORRECTION,  // 图像矫正（含灰度化）
+    PROFILE_BINARY,      // 二值化（OTSU）
+    PROFILE_PREPROCESS,  // AI模型输入前处理
+    PROFILE_NNA,         // NNA推理
+    PROFILE_ONNX,        // ONNX推理
+    PROFILE_NMS,         // NMS（PPNC或内置后处理）
+    PROFILE_PROPAGATION, // 检测框光流传播
+    PROFILE_TRACKER,     // 目标跟踪（SORT）
+    PROFILE_TRACKING,    // 赛道识别
+    PROFILE_STOP,        // 停车区检测
+    PROFILE_CATERING,    // 快餐店检测
+    PROFILE_LAYBY,       // 临时停车区检测
+    PROFILE_PARKING,     // 充电停车场检测
+    PROFILE_BRIDGE,      // 坡道区检测
+    PROFILE_OBSTACLE,    // 障碍区检测
+    PROFILE_CROSS,       // 十字道路识别
+    PROFILE_RING,        // 环岛识别
+    PROFILE_FITTING,     // 控制中心拟合
+    PROFILE_UART,        // 串口下发
+    PROFILE_COUNT
+};
+
+class Profiler
+{
+public:
+    bool enable = false; // 计时使能（启动前设置）
+
+    Profiler()
+    {
+#if defined(__aarch64__)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        nsPerTick = 1e9 / frequency;
+#endif
+    }
+
+    /**
+     * @brief 单调时钟
+     *
+     * @return uint64_t 时钟计数（aarch64：通用定时器计数；其余平台：ns）
+     */
+    static uint64_t ticks(void)
+    {
+#if defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+    /**
+     * @brief 时钟计数换算为ms
+     *
+     */
+    double milliseconds(uint64_t ticks) const { return ticks * nsPerTick / 1e6; }
+
+    /**
+     * @brief 时钟计数周期（ns）
+     *
+     */
+    double tick(void) const { return nsPerTick; }
+
+    /**
+     * @brief 阶段名称
+     *
+     */
+    static const char *name(int stage) { return NAMES[stage]; }
+
+    /**
+     * @brief 启动统计
+     *
+     * @param path 输出文件（空：标准输出）
+     * @param period 周期输出间隔（s，0：仅SIGUSR1/退出时输出）
+     */
+    void start(const std::string &path, double period)
+    {
+        this->path = path;
+        this->period = period > 0 ? (uint64_t)(period * 1e9 / nsPerTick) : 0;
+        timeStart = timeDump = ticks();
+        struct sigaction action = {};
+        action.sa_handler = [](int) { requested.store(true, std::memory_order_relaxed); };
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &action, nullptr);
+        enable = true;
+    }
+
+    /**
+     * @brief 设置阶段时限（超过计为超时）
+     *
+     * @param stage 阶段
+     * @param ms 时限（ms，0：不统计）
+     */
+    void deadline(int stage, double ms)
+    {
+        histograms[stage].deadline = (uint64_t)(ms * 1e6 / nsPerTick);
+    }
+
+    /**
+     * @brief [02-03] 记录一次耗时
+     *
+     * @param stage 阶段
+     * @param elapsed 耗时（时钟计数）
+     */
+    void record(int stage, uint64_t elapsed)
+    {
+        Histogram &h = histograms[stage];
+        h.buckets[bucket(elapsed)].fetch_add(1, std::memory_order_relaxed);
+        h.sum.fetch_add(elapsed, std::memory_order_relaxed);
+        uint64_t max = h.max.load(std::memory_order_relaxed);
+        while (elapsed > max && !h.max.compare_exchange_weak(max, elapsed, std::memory_order_relaxed))
+            ;
+        if (h.deadline && elapsed > h.deadline)
+            h.misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief [04] 按需输出（每帧调用）
+     *
+     */
+    void poll(void)
+    {
+        if (!enable)
+            return;
+        const bool signaled = requested.exchange(false, std::memory_order_relaxed);
+        if (signaled || (period && ticks() - timeDump >= period))
+            dump();
+    }
+
+    /**
+     * @brief 输出各阶段统计
+     *
+     */
+    void dump(void)
+    {
+        if (!enable)
+            return;
+        timeDump = ticks();
+        FILE *file = path.empty() ? stdout : fopen(path.c_str(), "a");
+        if (!file)
+        {
+            printf("[Profiler] 无法打开输出文件: %s\n", path.c_str());
+            return;
+        }
+
+        fprintf(file, "------------[Profiler] %.1fs------------\n", milliseconds(timeDump - timeStart) / 1000);
+        fprintf(file, "%-12s %10s %10s %10s %10s %10s %8s\n", "stage", "count", "mean(ms)", "p50(ms)", "p99(ms)", "max(ms)", "miss");
+        for (int stage = 0; stage < PROFILE_COUNT; stage++)
+        {
+            const Histogram &h = histograms[stage];
+            uint32_t counts[BUCKETS];
+            uint64_t count = 0;
+            for (int i = 0; i < BUCKETS; i++)
+            {
+                counts[i] = h.buckets[i].load(std::memory_order_relaxed);
+                count += counts[i];
+            }
+            if (count == 0)
+                continue;
+
+            const uint64_t max = h.max.load(std::memory_order_relaxed);
+            fprintf(file, "%-12s %10lu %10.3f %10.3f %10.3f %10.3f ", NAMES[stage], (unsigned long)count,
+                    milliseconds(h.sum.load(std::memory_order_relaxed)) / count,
+                    milliseconds(percentile(counts, count, 0.50, max)),
+                    milliseconds(percentile(counts, count, 0.99, max)), milliseconds(max));
+            if (h.deadline)
+                fprintf(file, "%8lu\n", (unsigned long)h.misses.load(std::memory_order_relaxed));
+            else
+                fprintf(file, "%8s\n", "-");
+        }
+        if (file != stdout)
+            fclose(file);
+        else
+            fflush(file);
+    }
+
+private:
+    static constexpr int SUB_BITS = 4;                        // 每2倍区间的子桶位数
+    static constexpr int SUB = 1 << SUB_BITS;                 // 每2倍区间的子桶数
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB; // 桶数：覆盖全部64位计数
+
+    static constexpr const char *NAMES[PROFILE_COUNT] = {
+        "frame", "capture", "correction", "binary", "preprocess", "nna", "onnx", "nms", "propagation", "tracker",
+        "tracking", "stop", "catering", "layby", "parking", "bridge", "obstacle", "cross", "ring", "fitting", "uart"};
+
+    /**
+     * @brief 单阶段直方图
+     *
+     */
+    struct Histogram
+    {
+        std::atomic<uint32_t> buckets[BUCKETS] = {}; // 对数分桶计数
+        std::atomic<uint64_t> sum{0};                // 总耗时
+        std::atomic<uint64_t> max{0};                // 最大耗时
+        std::atomic<uint64_t> misses{0};             // 超时次数
+        uint64_t deadline = 0;                       // 时限（0：不统计）
+    };
+
+    static inline std::atomic<bool> requested{false}; // SIGUSR1输出请求
+
+    Histogram histograms[PROFILE_COUNT]; // 各阶段直方图
+    double nsPerTick = 1;                // 时钟计数周期（ns）
+    std::string path;                    // 输出文件（空：标准输出）
+    uint64_t period = 0;                 // 周期输出间隔（时钟计数）
+    uint64_t timeStart = 0;              // 启动时刻
+    uint64_t timeDump = 0;               // 上次输出时刻
+
+    /**
+     * @brief 桶序号：小于SUB直接对应，否则按最高位（2倍区间）+次高SUB_BITS位（子桶）
+     *
+     */
+    static int bucket(uint64_t value)
+    {
+        if (value < SUB)
+            return value;
+        const int exponent = 63 - __builtin_clzll(value);
+        return (exponent - SUB_BITS + 1) * SUB + (int)((value >> (exponent - SUB_BITS)) & (SUB - 1));
+    }
+
+    /**
+     * @brief 桶上界
+     *
+     */
+    static uint64_t upper(int index)
+    {
+        if (index < SUB)
+            return index;
+        const int exponent = index / SUB + SUB_BITS - 1;
+        const uint64_t width = 1ull << (exponent - SUB_BITS);
+        return ((uint64_t)(SUB + index % SUB) << (exponent - SUB_BITS)) + width - 1;
+    }
+
+    /**
+     * @brief 分位数（所在桶上界，不超过最大值）
+     *
+     */
+    static uint64_t percentile(const uint32_t *counts, uint64_t count, double quantile, uint64_t max)
+    {
+        const uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(quantile * count), 1);
+        uint64_t accumulated = 0;
+        for (int i = 0; i < BUCKETS; i++)
+        {
+            accumulated += counts[i];
+            if (accumulated >= rank)
+                return upper(i) < max ? upper(i) : max;
+        }
+        return max;
+    }
+};
+
+inline Profiler profiler; // 全局计时统计（各线程共享）
+
+/**
+ * @brief [01] 作用域计时：构造时开始，析构时记录（耗时统计与时间线追踪）
+ *
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(int stage)
+        : stage(stage), start(profiler.enable || tracer.enabled() ? Profiler::ticks() : 0) {}
+    ~ProfileScope()
+    {
+        if (!start)
+            return;
+        const uint64_t end = Profiler::ticks();
+        if (profiler.enable)
+            profiler.record(stage, end - start);
+        if (tracer.enabled())
+            tracer.complete(Profiler::name(stage), start, end);
+    }
+
+private:
+    int stage;      // 阶段
+    uint64_t start; // 开始时刻（0：未使能）
+};
@@ -0,0 +1,192 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file propagation.hpp
+ * @author HC
+ * @brief 检测框帧间传播：稀疏光流（金字塔LK）跟踪关键帧检测框，非关键帧无需AI推理
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 每帧灰度化并构建一次光流金字塔，与上一帧金字塔交替复用
+ *                  [02] 每个检测框内取GRID×GRID均匀网格点，前向+后向LK光流，前后向误差超限的点剔除
+ *                  [03] 有效点位移中值→框平移，有效点到中心距离之比中值→框缩放
+ *                  [04] 有效点不足/框大部分移出图像时判定丢失，由调用方提前触发关键帧；保留的框裁剪到图像内
+ *       网格点代替角点检测：标志牌纹理丰富，均匀网格点足够稳定，且无需逐帧检测特征
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <opencv2/video.hpp>
+
+class BoxPropagation
+{
+public:
+    /**
+     * @brief 初始化
+     *
+     */
+    BoxPropagation()
+    {
+        points[0].reserve(BOX_MAX * GRID * GRID);
+        points[1].reserve(BOX_MAX * GRID * GRID);
+        points[2].reserve(BOX_MAX * GRID * GRID);
+        status[0].reserve(BOX_MAX * GRID * GRID);
+        status[1].reserve(BOX_MAX * GRID * GRID);
+        errors.reserve(BOX_MAX * GRID * GRID);
+        values[0].reserve(GRID * GRID);
+        values[1].reserve(GRID * GRID);
+        values[2].reserve(GRID * GRID);
+    }
+
+    /**
+     * @brief [01] 载入新一帧图像（关键帧与传播帧均需调用，保证光流基于相邻帧）
+     *
+     * @param img 输入图像（BGR）
+     */
+    void update(const cv::Mat &img)
+    {
+        std::swap(gray[0], gray[1]);
+        std::swap(pyramid[0], pyramid[1]);
+        cv::cvtColor(img, gray[1], cv::COLOR_BGR2GRAY);
+        cv::buildOpticalFlowPyramid(gray[1], pyramid[1], cv::Size(WINDOW, WINDOW), LEVELS);
+        frames++;
+    }
+
+    /**
+     * @brief 检测框由上一帧传播到当前帧（需先调用update载入当前帧）
+     *
+     * @param boxes 检测框（原地更新）
+     * @param lost 检测框丢失标志（输出，与boxes一一对应）
+     * @return int 丢失的检测框数
+     */
+    int propagate(std::vector<cv::Rect2f> &boxes, std::vector<bool> &lost)
+    {
+        lost.assign(boxes.size(), false);
+        if (boxes.empty())
+            return 0;
+        if (frames < 2 || gray[0].size() != gray[1].size())
+        {
+            lost.assign(boxes.size(), true);
+            return boxes.size();
+        }
+
+        // [02] 网格点前向+后向光流
+        points[0].clear();
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            const cv::Rect2f &box = boxes[i];
+            for (int r = 0; r < GRID; r++)
+                for (int c = 0; c < GRID; c++)
+                    points[0].emplace_back(box.x + box.width * (c + 1) / (GRID + 1),
+                                           box.y + box.height * (r + 1) / (GRID + 1));
+        }
+        const cv::TermCriteria criteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 20, 0.03);
+        cv::calcOpticalFlowPyrLK(pyramid[0], pyramid[1], points[0], points[1], status[0], errors,
+                                 cv::Size(WINDOW, WINDOW), LEVELS, criteria);
+        cv::calcOpticalFlowPyrLK(pyramid[1], pyramid[0], points[1], points[2], status[1], errors,
+                                 cv::Size(WINDOW, WINDOW), LEVELS, criteria);
+
+        // [03] 逐框估计平移与缩放
+        const cv::Rect2f bound(0, 0, gray[1].cols, gray[1].rows);
+        int count = 0;
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            values[0].clear();
+            values[1].clear();
+            const size_t begin = i * GRID * GRID, end = begin + GRID * GRID;
+            for (size_t k = begin; k < end; k++)
+            {
+                if (!status[0][k] || !status[1][k])
+                    continue;
+                const cv::Point2f back = points[2][k] - points[0][k];
+                if (back.dot(back) > FB_ERROR * FB_ERROR)
+                    continue;
+                values[0].push_back(points[1][k].x - points[0][k].x);
+                values[1].push_back(points[1][k].y - points[0][k].y);
+            }
+
+            // [04] 有效点不足：丢失
+            if ((int)values[0].size() < GRID * GRID / 2)
+            {
+                lost[i] = true;
+                count++;
+                continue;
+            }
+            const float dx = median(values[0]), dy = median(values[1]);
+
+            const cv::Point2f center0(boxes[i].x + boxes[i].width / 2, boxes[i].y + boxes[i].height / 2);
+            const cv::Point2f center1 = center0 + cv::Point2f(dx, dy);
+            values[2].clear();
+            for (size_t k = begin; k < end; k++)
+            {
+                const cv::Point2f back = points[2][k] - points[0][k];
+                if (!status[0][k] || !status[1][k] || back.dot(back) > FB_ERROR * FB_ERROR)
+                    continue;
+                const float d0 = cv::norm(points[0][k] - center0);
+                if (d0 > 1.f)
+                    values[2].push_back(cv::norm(points[1][k] - center1) / d0);
+            }
+            float scale = values[2].empty() ? 1.f : median(values[2]);
+            scale = std::min(std::max(scale, 1.f / SCALE_MAX), SCALE_MAX);
+
+            cv::Rect2f box;
+            box.width = boxes[i].width * scale;
+            box.height = boxes[i].height * scale;
+            box.x = center1.x - box.width / 2;
+            box.y = center1.y - box.height / 2;
+
+            // 框大部分移出图像：丢失；其余裁剪到图像内（同推理输出）
+            const cv::Rect2f inside = box & bound;
+            if (inside.area() < box.area() / 2)
+            {
+                lost[i] = true;
+                count++;
+                continue;
+            }
+            boxes[i] = inside;
+        }
+        return count;
+    }
+
+private:
+    static constexpr int GRID = 4;            // 每个检测框的网格点数（GRID×GRID）
+    static constexpr int WINDOW = 15;         // LK光流窗口
+    static constexpr int LEVELS = 2;          // 金字塔层数
+    static constexpr int BOX_MAX = 16;        // 预分配检测框数（超过时自动扩容）
+    static constexpr float FB_ERROR = 1.0f;   // 前后向误差阈值（像素）
+    static constexpr float SCALE_MAX = 1.25f; // 单帧最大缩放
+
+    cv::Mat gray[2];                         // 上一帧/当前帧灰度图
+    std::vector<cv::Mat> pyramid[2];         // 上一帧/当前帧光流金字塔
+    std::vector<cv::Point2f> points[3];      // 网格点：上一帧/前向跟踪/后向跟踪
+    std::vector<uchar> status[2];            // 前向/后向跟踪状态
+    std::vector<float> errors;               // LK跟踪误差（未使用）
+    std::vector<float> values[3];            // 有效点的x位移/y位移/缩放
+    uint64_t frames = 0;                     // 已载入帧数
+
+    /**
+     * @brief 中值（部分排序，会打乱输入顺序）
+     *
+     */
+    static float median(std::vector<float> &data)
+    {
+        std::nth_element(data.begin(), data.begin() + data.size() / 2, data.end());
+        return data[data.size() / 2];
+    }
+};
\ No newline at end of file
@@ -0,0 +1,158 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file rowscan.hpp
+ * @author HC
+ * @brief 二值图像行色块提取（SIMD）：逐行搜索白色色块的起点/终点
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 比较+movemask：每次16/32个像素生成行位图（bit = 像素>127，即像素最高位）
+ *                  [02] 位图与左移一位的自身异或，得到跳变位置（上升沿/下降沿）
+ *                  [03] 按位序遍历跳变位置，写入色块起点/终点数组
+ *       指令集：AVX2(32像素) / SSE2(16像素) / NEON-aarch64(16像素) / 标量兜底
+ *       输出与Tracking原逐像素扫描完全一致（包括首列判定与色块数上限的处理）
+ */
+
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define ROWSCAN_WORDS(cols) (((cols) + 63) / 64) // 行位图字数
+
+/**
+ * @brief 行位图：bits[col/64]的第col%64位 = row[col] > 127
+ *
+ * @param row 行像素
+ * @param cols 列数
+ * @param bits 输出位图（ROWSCAN_WORDS(cols)个字）
+ */
+inline void rowBits(const uint8_t *row, int cols, uint64_t *bits)
+{
+    for (int w = 0; w < ROWSCAN_WORDS(cols); w++)
+        bits[w] = 0;
+
+    int col = 0;
+#if defined(__AVX2__)
+    for (; col + 32 <= cols; col += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(row + col));
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(v); // 最高位即>127
+        bits[col >> 6] |= mask << (col & 63);
+    }
+#elif defined(__SSE2__)
+    for (; col + 16 <= cols; col += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(row + col));
+        uint64_t mask = (uint32_t)_mm_movemask_epi8(v); // 最高位即>127
+        bits[col >> 6] |= mask << (col & 63);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static const int8_t shifts[16] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7};
+    const int8x16_t shift = vld1q_s8(shifts);
+    for (; col + 16 <= cols; col += 16)
+    {
+        uint8x16_t v = vshrq_n_u8(vld1q_u8(row + col), 7); // 最高位→0/1
+        v = vshlq_u8(v, shift);                            // 移至各自位序
+        uint64_t mask = vaddv_u8(vget_low_u8(v)) | ((uint64_t)vaddv_u8(vget_high_u8(v)) << 8);
+        bits[col >> 6] |= mask << (col & 63);
+    }
+#endif
+    for (; col < cols; col++) // 标量兜底/行尾
+        bits[col >> 6] |= (uint64_t)(row[col] >> 7) << (col & 63);
+}
+
+/**
+ * @brief 行色块提取（位图跳变法）
+ *
+ * @param row 行像素（二值图像）
+ * @param cols 列数（不超过1024）
+ * @param startBlock 色块起点数组（仅在出现起点时写入）
+ * @param endBlock 色块终点数组
+ * @param capacity 数组容量
+ * @return int 色块数
+ */
+inline int rowBlocks(const uint8_t *row, int cols, int *startBlock, int *endBlock, int capacity)
+{
+    uint64_t bits[16] = {0};
+    rowBits(row, cols, bits);
+
+    int counterBlock = 0;
+    if (bits[0] & 2) // 与原实现一致：第1列为白时起点记为0
+        startBlock[0] = 0;
+
+    const int words = ROWSCAN_WORDS(cols);
+    uint64_t carry = 0; // 上一字的最高位
+    for (int w = 0; w < words && counterBlock < capacity; w++)
+    {
+        uint64_t edges = bits[w] ^ ((bits[w] << 1) | carry); // 跳变：与左侧像素不同
+        carry = bits[w] >> 63;
+        if (w == 0)
+            edges &= ~1ull; // 从第1列开始比较
+        if (w == words - 1 && (cols & 63))
+            edges &= (1ull << (cols & 63)) - 1;
+
+        while (edges)
+        {
+            int bit = __builtin_ctzll(edges);
+            edges &= edges - 1;
+            int col = (w << 6) + bit;
+            if ((bits[w] >> bit) & 1) // 上升沿：色块起点
+                startBlock[counterBlock] = col;
+            else // 下降沿：色块终点
+            {
+                endBlock[counterBlock++] = col;
+                if (counterBlock >= capacity)
+                    break;
+            }
+        }
+    }
+
+    if (row[cols - 1] > 127 && counterBlock < capacity - 1) // 行尾为白：补齐终点
+        endBlock[counterBlock++] = cols - 1;
+    return counterBlock;
+}
+
+/**
+ * @brief 行色块提取（原逐像素扫描，用于基准对比与校验）
+ *
+ */
+inline int rowBlocksScalar(const uint8_t *row, int cols, int *startBlock, int *endBlock, int capacity)
+{
+    int counterBlock = 0;
+    if (row[1] > 127)
+        startBlock[counterBlock] = 0;
+    for (int col = 1; col < cols; col++) // 搜索出每行的所有色块
+    {
+        if (row[col] > 127 && row[col - 1] <= 127)
+            startBlock[counterBlock] = col;
+        else if (row[col] <= 127 && row[col - 1] > 127)
+        {
+            endBlock[counterBlock++] = col;
+            if (counterBlock >= capacity)
+                break;
+        }
+    }
+    if (row[cols - 1] > 127 && counterBlock < capacity - 1)
+        endBlock[counterBlock++] = cols - 1;
+    return counterBlock;
+}
\ No newline at end of file
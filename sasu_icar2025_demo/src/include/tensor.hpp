@@ -0,0 +1,262 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file tensor.hpp
+ * @author HC
+ * @brief AI模型输入前处理：单次遍历完成 缩放（双三次）+BGR→RGB+归一化+HWC→CHW
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 源尺寸变化时预计算行/列的双三次插值索引与定点系数（与cv::resize的INTER_CUBIC定点实现一致）
+ *                  [02] 逐行水平插值（int32，缓存最近4个源行，放大时相邻输出行复用）
+ *                  [03] 垂直插值+舍入饱和得到uint8（与cv::resize输出逐像素一致）
+ *                  [04] 查表完成 /255、减均值、除方差（查找表按原float运算顺序生成），按RGB顺序写入CHW平面
+ *       原实现：cvtColor→resize→convertTo→×1/255→subtract→multiply→split→memcpy，7次整图遍历+多张float临时图像
+ *       水平/垂直插值的内层循环为连续int32乘加，由编译器向量化（-O3：NEON/SSE/AVX）
+ */
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+class TensorInput
+{
+public:
+    /**
+     * @brief 初始化
+     *
+     * @param sizeDst 模型输入尺寸
+     * @param mean 均值（RGB）
+     * @param stdev 标准差（RGB）
+     */
+    TensorInput(cv::Size sizeDst, const double mean[3], const double stdev[3]) : sizeDst(sizeDst)
+    {
+        const float scale = (float)(1 / 255.0);
+        for (int c = 0; c < 3; c++)
+        {
+            this->mean[c] = mean[c];
+            this->stdev[c] = stdev[c];
+            const float sub = (float)mean[c], mul = (float)(1 / stdev[c]);
+            for (int v = 0; v < 256; v++)
+            {
+                volatile float x = (float)v * scale; // 逐步舍入：与原实现的逐次整图运算一致
+                x = x - sub;
+                lut[c][v] = x * mul;
+            }
+        }
+    }
+
+    /**
+     * @brief 融合前处理：BGR图像→CHW浮点张量
+     *
+     * @param frame 输入图像（CV_8UC3，BGR）
+     * @param tensor 输出张量（3×H×W，RGB）
+     */
+    void process(const cv::Mat &frame, float *tensor)
+    {
+        if (frame.cols != sizeSrc.width || frame.rows != sizeSrc.height)
+            build(cv::Size(frame.cols, frame.rows));
+
+        const int widthDst = sizeDst.width * 3;
+        const int plane = sizeDst.width * sizeDst.height;
+        for (int k = 0; k < 4; k++)
+            rowTag[k] = -1;
+
+        for (int dy = 0; dy < sizeDst.height; dy++)
+        {
+            // [02] 本行所需的4个源行：命中缓存直接复用，否则水平插值到空闲缓存
+            const int *rows[4];
+            for (int k = 0; k < 4; k++)
+            {
+                const int sy = yofs[dy * 4 + k];
+                int slot = -1;
+                for (int j = 0; j < 4 && slot < 0; j++)
+                    if (rowTag[j] == sy)
+                        slot = j;
+                if (slot < 0)
+                {
+                    slot = freeSlot(&yofs[dy * 4]);
+                    rowTag[slot] = sy;
+                    horizontal(frame.ptr<uchar>(sy), rowBuffer[slot].data());
+                }
+                rows[k] = rowBuffer[slot].data();
+            }
+
+            // [03] 垂直插值：定点舍入（22位）+饱和
+            const short *beta = &ibeta[dy * 4];
+            const int b0 = beta[0], b1 = beta[1], b2 = beta[2], b3 = beta[3];
+            const int *r0 = rows[0], *r1 = rows[1], *r2 = rows[2], *r3 = rows[3];
+            uchar *pixels = rowPixels.data();
+            for (int x = 0; x < widthDst; x++)
+            {
+                int v = (r0[x] * b0 + r1[x] * b1 + r2[x] * b2 + r3[x] * b3 + (1 << (COEF_BITS * 2 - 1))) >> (COEF_BITS * 2);
+                pixels[x] = (uchar)(v < 0 ? 0 : (v > 255 ? 255 : v));
+            }
+
+            // [04] 查表归一化，BGR→RGB写入CHW平面
+            float *planeR = tensor + dy * sizeDst.width;
+            float *planeG = planeR + plane;
+            float *planeB = planeG + plane;
+            for (int dx = 0; dx < sizeDst.width; dx++)
+            {
+                planeB[dx] = lut[2][pixels[dx * 3]];
+                planeG[dx] = lut[1][pixels[dx * 3 + 1]];
+                planeR[dx] = lut[0][pixels[dx * 3 + 2]];
+            }
+        }
+    }
+
+    /**
+     * @brief 原实现（OpenCV逐步处理），用于校验与基准对比
+     *
+     * @param frame 输入图像（CV_8UC3，BGR）
+     * @param tensor 输出张量（3×H×W，RGB）
+     */
+    void processLegacy(const cv::Mat &frame, float *tensor) const
+    {
+        cv::Mat x;
+        cv::cvtColor(frame, x, cv::COLOR_BGR2RGB);
+        cv::resize(x, x, sizeDst, 0, 0, 2);
+        x.convertTo(x, CV_32FC3);
+        x *= 1 / 255.0;
+        cv::subtract(x, cv::Scalar(mean[0], mean[1], mean[2]), x);
+        cv::multiply(x, cv::Scalar(1 / stdev[0], 1 / stdev[1], 1 / stdev[2]), x);
+
+        cv::Mat channels[3];
+        cv::split(x, channels);
+        const int offset = x.rows * x.cols;
+        for (int i = 0; i < 3; ++i)
+            std::memcpy(tensor + i * offset, channels[i].data, offset * sizeof(float));
+    }
+
+private:
+    static constexpr int COEF_BITS = 11; // 插值系数定点位数（同OpenCV INTER_RESIZE_COEF_BITS）
+
+    cv::Size sizeSrc = cv::Size(0, 0); // 输入图像尺寸
+    cv::Size sizeDst;                  // 模型输入尺寸
+    double mean[3];                    // 均值（RGB）
+    double stdev[3];                   // 标准差（RGB）
+    float lut[3][256];                 // 归一化查找表（RGB）
+    std::vector<int> xofs;             // 列插值源像素序号（每输出像素4个）
+    std::vector<short> ialpha;         // 列插值定点系数
+    std::vector<int> yofs;             // 行插值源行（每输出行4个）
+    std::vector<short> ibeta;          // 行插值定点系数
+    bool identityX = false;            // 水平方向无缩放
+    std::vector<int> rowBuffer[4];     // 水平插值结果缓存（int32）
+    int rowTag[4] = {-1, -1, -1, -1};  // 缓存对应的源行
+    std::vector<uchar> rowPixels;      // 单行uint8插值结果
+
+    /**
+     * @brief 双三次插值系数（同OpenCV interpolateCubic）
+     *
+     */
+    static void cubic(float x, float coeffs[4])
+    {
+        const float A = -0.75f;
+        coeffs[0] = ((A * (x + 1) - 5 * A) * (x + 1) + 8 * A) * (x + 1) - 4 * A;
+        coeffs[1] = ((A + 2) * x - (A + 3)) * x * x + 1;
+        coeffs[2] = ((A + 2) * (1 - x) - (A + 3)) * (1 - x) * (1 - x) + 1;
+        coeffs[3] = 1.f - coeffs[0] - coeffs[1] - coeffs[2];
+    }
+
+    /**
+     * @brief 单方向插值表：源坐标越界时取边界像素（同cv::resize）
+     *
+     */
+    static void table(int sizeSrc, int sizeDst, std::vector<int> &offsets, std::vector<short> &coeffs)
+    {
+        const double scale = 1. / ((double)sizeDst / sizeSrc);
+        offsets.resize(sizeDst * 4);
+        coeffs.resize(sizeDst * 4);
+        for (int d = 0; d < sizeDst; d++)
+        {
+            float f = (float)((d + 0.5) * scale - 0.5);
+            int s = (int)std::floor(f);
+            f -= s;
+
+            float cbuf[4];
+            cubic(f, cbuf);
+            for (int k = 0; k < 4; k++)
+            {
+                offsets[d * 4 + k] = std::min(std::max(s - 1 + k, 0), sizeSrc - 1);
+                coeffs[d * 4 + k] = cv::saturate_cast<short>(cbuf[k] * (1 << COEF_BITS));
+            }
+        }
+    }
+
+    /**
+     * @brief [01] 预计算插值表
+     *
+     */
+    void build(cv::Size size)
+    {
+        sizeSrc = size;
+        table(sizeSrc.width, sizeDst.width, xofs, ialpha);
+        table(sizeSrc.height, sizeDst.height, yofs, ibeta);
+
+        identityX = sizeSrc.width == sizeDst.width;
+        for (int dx = 0; dx < sizeDst.width && identityX; dx++)
+            identityX = xofs[dx * 4 + 1] == dx && ialpha[dx * 4 + 1] == (1 << COEF_BITS);
+
+        for (int k = 0; k < 4; k++)
+            rowBuffer[k].assign(sizeDst.width * 3, 0);
+        rowPixels.assign(sizeDst.width * 3, 0);
+    }
+
+    /**
+     * @brief 空闲缓存：不属于本行所需源行的缓存
+     *
+     * @param needed 本行所需的4个源行
+     */
+    int freeSlot(const int *needed) const
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            bool used = false;
+            for (int k = 0; k < 4; k++)
+                used |= rowTag[j] == needed[k];
+            if (!used)
+                return j;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief [02] 单行水平插值（三通道交错）
+     *
+     */
+    void horizontal(const uchar *src, int *dst) const
+    {
+        const int widthDst = sizeDst.width * 3;
+        if (identityX) // 水平无缩放：系数为(0,1,0,0)
+        {
+            for (int x = 0; x < widthDst; x++)
+                dst[x] = src[x] << COEF_BITS;
+            return;
+        }
+
+        for (int dx = 0; dx < sizeDst.width; dx++)
+        {
+            const int *ofs = &xofs[dx * 4];
+            const short *alpha = &ialpha[dx * 4];
+            const uchar *s0 = src + ofs[0] * 3, *s1 = src + ofs[1] * 3;
+            const uchar *s2 = src + ofs[2] * 3, *s3 = src + ofs[3] * 3;
+            for (int c = 0; c < 3; c++)
+                dst[dx * 3 + c] = s0[c] * alpha[0] + s1[c] * alpha[1] + s2[c] * alpha[2] + s3[c] * alpha[3];
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,296 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file trace.hpp
+ * @author HC
+ * @brief 时间线追踪：各线程事件写入私有无锁队列，后台线程异步输出Chrome Trace Event JSON（Perfetto可直接打开）
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 线程首次记录事件时分配私有事件队列并登记（单生产者/单消费者环形队列，写入无锁）
+ *                  [02] 事件：阶段区间（X）、瞬时事件（i）、计数曲线（C）、整帧异步区间（b/e，采集→串口下发）
+ *                  [03] 每个事件附带本线程当前处理的帧序号（frame()设置），同一帧可跨线程对齐
+ *                  [04] 后台线程周期性取出各线程队列中的事件，格式化写入文件；队列满时丢弃并计数
+ *                  [05] stop()：取空剩余事件，补全JSON数组结尾
+ *       时间戳使用Profiler时钟计数，输出时换算为us（相对启动时刻）
+ *       事件名称必须为静态字符串（只保存指针）
+ */
+
+#include "pipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * @brief 追踪事件
+ *
+ */
+struct TraceEvent
+{
+    uint64_t begin = 0;         // 开始时刻（时钟计数）
+    uint64_t end = 0;           // 结束时刻（区间事件）
+    const char *name = nullptr; // 事件名称（静态字符串）
+    int64_t frame = -1;         // 帧序号（-1：无）
+    double value = 0;           // 计数值/附加参数
+    char phase = 'X';           // 事件类型：X区间 | i瞬时 | C计数 | F整帧异步区间
+};
+
+class Tracer
+{
+public:
+    ~Tracer() { stop(); }
+
+    /**
+     * @brief 追踪使能（启动后置位）：各线程事件入口只做relaxed读取
+     *
+     */
+    bool enabled(void) const { return enable.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 启动追踪与后台输出线程
+     *
+     * @param path 输出文件（.json）
+     * @param nsPerTick 时钟计数周期（ns）
+     * @param now 启动时刻（时钟计数）
+     */
+    bool start(const std::string &path, double nsPerTick, uint64_t now)
+    {
+        file = fopen(path.c_str(), "w");
+        if (!file)
+        {
+            printf("[Tracer] 无法打开输出文件: %s\n", path.c_str());
+            return false;
+        }
+        fprintf(file, "[\n");
+        this->nsPerTick = nsPerTick;
+        timeStart = now;
+        pid = getpid();
+        running = true;
+        threadFlush = std::thread([this]()
+                                  {
+            while (running.load(std::memory_order_relaxed))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(FLUSH_PERIOD));
+                flush();
+            } });
+        enable.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief [05] 停止追踪：输出剩余事件并关闭文件
+     *
+     */
+    void stop(void)
+    {
+        if (!enable.exchange(false))
+            return;
+        running = false;
+        if (threadFlush.joinable())
+            threadFlush.join();
+        flush();
+        uint64_t dropped = 0;
+        for (int i = 0; i < MAX_THREADS; i++)
+            if (ThreadBuffer *buffer = threads[i].load(std::memory_order_acquire))
+                dropped += buffer->dropped.load(std::memory_order_relaxed);
+        fprintf(file, "{\"name\":\"dropped\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"events\":%lu}}\n]\n", pid,
+                (unsigned long)dropped);
+        fclose(file);
+        file = nullptr;
+    }
+
+    /**
+     * @brief 设置本线程名称（时间线上的轨道名）
+     *
+     * @param name 线程名称（静态字符串）
+     */
+    void thread(const char *name)
+    {
+        if (!enabled())
+            return;
+        if (ThreadBuffer *buffer = local())
+            buffer->name.store(name, std::memory_order_release);
+    }
+
+    /**
+     * @brief [03] 设置本线程当前处理的帧序号
+     *
+     */
+    static void frame(int64_t seq) { frameCurrent = seq; }
+
+    /**
+     * @brief 阶段区间
+     *
+     */
+    void complete(const char *name, uint64_t begin, uint64_t end)
+    {
+        push({begin, end, name, frameCurrent, 0, 'X'});
+    }
+
+    /**
+     * @brief 瞬时事件
+     *
+     * @param value 附加参数
+     */
+    void instant(const char *name, uint64_t now, double value = 0)
+    {
+        push({now, now, name, frameCurrent, value, 'i'});
+    }
+
+    /**
+     * @brief 计数曲线（场景状态、NNA等待耗时等）
+     *
+     */
+    void counter(const char *name, uint64_t now, double value)
+    {
+        push({now, now, name, frameCurrent, value, 'C'});
+    }
+
+    /**
+     * @brief 整帧异步区间：采集→串口下发（跨线程，按帧序号配对）
+     *
+     * @param value 场景状态
+     */
+    void frameSpan(int64_t seq, uint64_t begin, uint64_t end, double value)
+    {
+        push({begin, end, "frame", seq, value, 'F'});
+    }
+
+private:
+    static constexpr int MAX_THREADS = 32;   // 最大线程数
+    static constexpr size_t CAPACITY = 8192; // 单线程事件队列容量（约0.4MB）
+    static constexpr int FLUSH_PERIOD = 100; // 输出周期（ms）
+
+    /**
+     * @brief 线程私有事件队列
+     *
+     */
+    struct ThreadBuffer
+    {
+        RingBuffer<TraceEvent, CAPACITY> events; // 事件队列（本线程写，输出线程读）
+        std::atomic<const char *> name{nullptr}; // 线程名称
+        std::atomic<uint64_t> dropped{0};        // 队列满丢弃事件数
+        int tid = 0;                             // 线程号
+        bool named = false;                      // 已输出线程名称（输出线程独占）
+    };
+
+    static inline thread_local ThreadBuffer *threadLocal = nullptr; // 本线程事件队列
+    static inline thread_local int64_t frameCurrent = -1;           // 本线程当前帧序号
+
+    std::atomic<ThreadBuffer *> threads[MAX_THREADS] = {}; // 已登记线程（只增不删）
+    std::atomic<int> count{0};                             // 已登记线程数
+    std::atomic<bool> enable{false};                       // 追踪使能：各线程事件入口读取，start/stop写入
+    std::atomic<bool> running{false};                      // 输出线程运行标志
+    std::thread threadFlush;                               // 输出线程
+    FILE *file = nullptr;                                  // 输出文件（仅输出线程/stop写入）
+    double nsPerTick = 1;                                  // 时钟计数周期（ns）
+    uint64_t timeStart = 0;                                // 启动时刻
+    int pid = 0;                                           // 进程号
+
+    /**
+     * @brief [01] 本线程事件队列（首次调用时分配并登记）
+     *
+     */
+    ThreadBuffer *local(void)
+    {
+        if (threadLocal)
+            return threadLocal;
+        const int index = count.fetch_add(1, std::memory_order_relaxed);
+        if (index >= MAX_THREADS)
+            return nullptr;
+        threadLocal = new ThreadBuffer; // 线程退出后保留：输出线程仍可能读取
+        threadLocal->tid = syscall(SYS_gettid);
+        threads[index].store(threadLocal, std::memory_order_release);
+        return threadLocal;
+    }
+
+    /**
+     * @brief [02] 写入本线程事件队列
+     *
+     */
+    void push(TraceEvent &&event)
+    {
+        if (!enabled())
+            return;
+        ThreadBuffer *buffer = local();
+        if (buffer && !buffer->events.push(std::move(event)))
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 时钟计数换算为us（相对启动时刻）
+     *
+     */
+    double micros(uint64_t ticks) const { return (double)(int64_t)(ticks - timeStart) * nsPerTick / 1000; }
+
+    /**
+     * @brief [04] 取出各线程事件并写入文件
+     *
+     */
+    void flush(void)
+    {
+        TraceEvent event;
+        const int n = std::min(count.load(std::memory_order_relaxed), MAX_THREADS);
+        for (int i = 0; i < n; i++)
+        {
+            ThreadBuffer *buffer = threads[i].load(std::memory_order_acquire);
+            if (!buffer) // 正在登记
+                continue;
+            const char *name = buffer->name.load(std::memory_order_acquire);
+            if (name && !buffer->named)
+            {
+                fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+                        pid, buffer->tid, name);
+                buffer->named = true;
+            }
+
+            while (buffer->events.pop(event))
+            {
+                switch (event.phase)
+                {
+                case 'X':
+                    fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%ld}},\n",
+                            event.name, pid, buffer->tid, micros(event.begin), micros(event.end) - micros(event.begin),
+                            (long)event.frame);
+                    break;
+                case 'i':
+                    fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"args\":{\"frame\":%ld,\"value\":%g}},\n",
+                            event.name, pid, buffer->tid, micros(event.begin), (long)event.frame, event.value);
+                    break;
+                case 'C':
+                    fprintf(file, "{\"name\":\"%s\",\"ph\":\"C\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%g}},\n",
+                            event.name, pid, buffer->tid, micros(event.begin), event.value);
+                    break;
+                case 'F':
+                    fprintf(file, "{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"b\",\"id\":%ld,\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"args\":{\"frame\":%ld,\"scene\":%g}},\n",
+                            event.name, (long)event.frame, pid, buffer->tid, micros(event.begin), (long)event.frame, event.value);
+                    fprintf(file, "{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"e\",\"id\":%ld,\"pid\":%d,\"tid\":%d,\"ts\":%.3f},\n",
+                            event.name, (long)event.frame, pid, buffer->tid, micros(event.end));
+                    break;
+                }
+            }
+        }
+        fflush(file);
+    }
+};
+
+inline Tracer tracer; // 全局时间线追踪（各线程共享）
@@ -0,0 +1,270 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file tracker.hpp
+ * @author HC
+ * @brief AI检测多目标跟踪（SORT）：匀速卡尔曼预测+IoU关联，为检测结果分配稳定ID
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 全部跟踪目标卡尔曼预测一步（每次update为一步，与推理调用频率一致）
+ *                  [02] 检测框按置信度降序，逐个关联同类别、IoU最大且不低于阈值的未关联跟踪目标：O(n·m)
+ *                  [03] 关联成功：卡尔曼更新，命中数+1；未关联检测框：新建跟踪目标；未关联跟踪目标：丢失计数+1
+ *                  [04] 连续丢失超过maxAge的跟踪目标删除，检测结果回写跟踪ID（未确认为-1）
+ *       关键帧模式下光流传播帧只执行[01][02]（预测+关联回写ID），[03][04]只在AI推理关键帧执行，
+ *       因此hits/missed/maxAge按关键帧计数
+ *       状态量：中心x/y、宽、高及其速度。过程/观测噪声为对角阵，四个分量相互独立，
+ *       8维卡尔曼滤波严格等价于4个2维（位置, 速度）滤波，省去矩阵运算
+ *       跟踪目标与检测框均为定容量数组，帧循环内无堆内存分配
+ */
+
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "profiler.hpp"
+
+#define TRACK_CAPACITY 32 // 跟踪目标容量
+#define TRACK_INPUT 64    // 单帧参与关联的检测框容量
+
+class ObjectTracker
+{
+public:
+    float iouThreshold = 0.3f; // 关联IoU阈值
+    int maxAge = 3;            // 连续丢失帧数上限（超过后删除）
+    int minHits = 3;           // 确认所需命中数
+
+    /**
+     * @brief 跟踪目标
+     *
+     */
+    struct Track
+    {
+        int id;               // 跟踪ID（持续递增）
+        int type;             // 类别
+        float score;          // 最近一次关联的置信度
+        cv::Rect2f box;       // 滤波后的检测框
+        cv::Point2f velocity; // 中心速度（像素/帧）
+        int hits;             // 累计命中数
+        int age;              // 存活帧数
+        int missed;           // 连续丢失帧数
+        float state[4][2];    // 卡尔曼状态：[中心x, 中心y, 宽, 高] × [位置, 速度]
+        float cov[4][3];      // 卡尔曼协方差：[P00, P01, P11]
+
+        bool confirmed(int minHits) const { return hits >= minHits && missed == 0; }
+    };
+
+    int size(void) const { return count; }
+    const Track &operator[](int index) const { return tracks[index]; }
+
+    /**
+     * @brief 查询已确认的指定类别跟踪目标
+     *
+     * @param type 类别
+     * @return const Track* 命中数最多的跟踪目标（不存在时为nullptr）
+     */
+    const Track *confirmed(int type) const
+    {
+        const Track *best = nullptr;
+        for (int i = 0; i < count; i++)
+            if (tracks[i].type == type && tracks[i].confirmed(minHits) && (!best || tracks[i].hits > best->hits))
+                best = &tracks[i];
+        return best;
+    }
+
+    /**
+     * @brief 清空跟踪目标（视频源切换时）
+     *
+     */
+    void reset(void) { count = 0; }
+
+    /**
+     * @brief 跟踪更新
+     *
+     * @param results 检测结果集（支持size()与下标访问，元素含x/y/width/height/type/score/id字段），回写id
+     * @param measured 结果为观测（AI推理关键帧）；否则（光流传播帧）只预测并关联回写id，
+     *                 不做卡尔曼更新、不新建/不计丢失：传播框由上一观测外推，作为观测会重复计入同一测量
+     */
+    template <typename Results>
+    void update(Results &results, bool measured = true)
+    {
+        ProfileScope profile(PROFILE_TRACKER);
+
+        // [01] 预测
+        for (int i = 0; i < count; i++)
+            predict(tracks[i]);
+
+        // [02] 按置信度降序逐个关联（插入排序：单帧检测框数很少）
+        const int number = std::min((int)results.size(), TRACK_INPUT);
+        for (int i = 0; i < number; i++)
+        {
+            int j = i;
+            for (; j > 0 && results[order[j - 1]].score < results[i].score; j--)
+                order[j] = order[j - 1];
+            order[j] = i;
+        }
+        for (int i = 0; i < count; i++)
+            matched[i] = false;
+
+        for (int n = 0; n < number; n++)
+        {
+            auto &result = results[order[n]];
+            const cv::Rect2f box(result.x, result.y, result.width, result.height);
+            int best = -1;
+            float bestIou = iouThreshold;
+            for (int i = 0; i < count; i++)
+            {
+                if (matched[i] || tracks[i].type != result.type)
+                    continue;
+                const float value = iou(box, tracks[i].box);
+                if (value >= bestIou)
+                {
+                    best = i;
+                    bestIou = value;
+                }
+            }
+
+            // [03] 关联成功：更新；未关联：新建（仅观测帧）
+            if (best >= 0)
+            {
+                if (measured)
+                    correct(tracks[best], box, result.score);
+            }
+            else if (measured && count < TRACK_CAPACITY)
+            {
+                best = count++;
+                create(tracks[best], box, result.type, result.score);
+            }
+            if (best >= 0)
+            {
+                matched[best] = true;
+                result.id = tracks[best].hits >= minHits ? tracks[best].id : -1;
+            }
+            else
+                result.id = -1;
+        }
+        for (size_t n = number; n < results.size(); n++)
+            results[n].id = -1;
+        if (!measured)
+            return;
+
+        // [04] 未关联跟踪目标：丢失计数，超限删除（保持顺序压缩）
+        int kept = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (!matched[i])
+                tracks[i].missed++;
+            if (tracks[i].missed > maxAge)
+                continue;
+            if (kept != i)
+                tracks[kept] = tracks[i];
+            kept++;
+        }
+        count = kept;
+    }
+
+private:
+    static constexpr float STD_POSITION = 1.0f;   // 过程噪声：位置
+    static constexpr float STD_VELOCITY = 0.01f;  // 过程噪声：速度
+    static constexpr float STD_MEASURE = 1.0f;    // 观测噪声：中心
+    static constexpr float STD_SIZE = 10.0f;      // 观测噪声：宽高
+    static constexpr float COV_POSITION = 10.0f;  // 初始协方差：位置
+    static constexpr float COV_VELOCITY = 1000.f; // 初始协方差：速度（未知）
+
+    Track tracks[TRACK_CAPACITY];  // 跟踪目标
+    bool matched[TRACK_CAPACITY];  // 本帧已关联
+    int order[TRACK_INPUT];        // 检测框关联顺序
+    int count = 0;                 // 跟踪目标数
+    int idNext = 0;                // 下一个跟踪ID
+
+    static float iou(const cv::Rect2f &a, const cv::Rect2f &b)
+    {
+        const float inter = (a & b).area();
+        const float sum = a.area() + b.area() - inter;
+        return sum > 0 ? inter / sum : 0.f;
+    }
+
+    void create(Track &track, const cv::Rect2f &box, int type, float score)
+    {
+        const float measure[4] = {box.x + box.width / 2, box.y + box.height / 2, box.width, box.height};
+        track.id = idNext++;
+        track.type = type;
+        track.hits = 1;
+        track.age = 1;
+        track.missed = 0;
+        for (int k = 0; k < 4; k++)
+        {
+            track.state[k][0] = measure[k];
+            track.state[k][1] = 0;
+            track.cov[k][0] = COV_POSITION;
+            track.cov[k][1] = 0;
+            track.cov[k][2] = COV_VELOCITY;
+        }
+        output(track, score);
+    }
+
+    /**
+     * @brief 卡尔曼预测：x = Fx，P = FPF' + Q（F = [1 1; 0 1]）
+     *
+     */
+    void predict(Track &track)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            float *s = track.state[k], *p = track.cov[k];
+            s[0] += s[1];
+            p[0] += 2 * p[1] + p[2] + STD_POSITION;
+            p[1] += p[2];
+            p[2] += STD_VELOCITY;
+        }
+        track.state[2][0] = std::max(track.state[2][0], 1.f); // 宽高保持为正
+        track.state[3][0] = std::max(track.state[3][0], 1.f);
+        track.age++;
+        output(track, track.score);
+    }
+
+    /**
+     * @brief 卡尔曼更新（H = [1 0]）
+     *
+     */
+    void correct(Track &track, const cv::Rect2f &box, float score)
+    {
+        const float measure[4] = {box.x + box.width / 2, box.y + box.height / 2, box.width, box.height};
+        for (int k = 0; k < 4; k++)
+        {
+            float *s = track.state[k], *p = track.cov[k];
+            const float innovation = measure[k] - s[0];
+            const float gain0 = p[0] / (p[0] + (k < 2 ? STD_MEASURE : STD_SIZE));
+            const float gain1 = p[1] / (p[0] + (k < 2 ? STD_MEASURE : STD_SIZE));
+            s[0] += gain0 * innovation;
+            s[1] += gain1 * innovation;
+            p[2] -= gain1 * p[1];
+            p[1] *= 1 - gain0;
+            p[0] *= 1 - gain0;
+        }
+        track.hits++;
+        track.missed = 0;
+        output(track, score);
+    }
+
+    static void output(Track &track, float score)
+    {
+        track.score = score;
+        track.box.width = std::max(track.state[2][0], 1.f);
+        track.box.height = std::max(track.state[3][0], 1.f);
+        track.box.x = track.state[0][0] - track.box.width / 2;
+        track.box.y = track.state[1][0] - track.box.height / 2;
+        track.velocity = cv::Point2f(track.state[0][1], track.state[1][1]);
+    }
+};
\ No newline at end of file
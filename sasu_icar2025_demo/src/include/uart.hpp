@@ -24,6 +24,8 @@
  */
 
 #include "common.hpp"
+#include "profiler.hpp"         // 时间线追踪
+#include <atomic>
 #include <iostream>               // 输入输出类
 #include <libserial/SerialPort.h> // 串口通信
 #include <math.h>                 // 数学函数类
@@ -62,6 +64,7 @@ private:
   std::shared_ptr<SerialPort> serialPort = nullptr;
   std::string portName; // 端口名字
   bool isOpen = false;
+  std::atomic<bool> receiving{false}; // 接收子线程运行标志
   SerialStruct serialStr; // 串口通信数据结构体
 
   /**
@@ -210,8 +213,10 @@ public:
       return;
 
     // 启动串口接收子线程
+    receiving = true;
     threadRec = std::make_unique<std::thread>([this]() {
-      while (1) {
+      tracer.thread("uart rx");
+      while (receiving) {
         receiveCheck(); // 串口接收校验
       }
     });
@@ -224,7 +229,9 @@ public:
   void close(void) {
     printf(" uart thread exit!\n");
     carControl(0, PWMSERVOMID);
-    threadRec->join();
+    receiving = false; // 接收超时返回后退出
+    if (threadRec && threadRec->joinable())
+      threadRec->join();
     if (serialPort != nullptr) {
       serialPort->Close();
       serialPort = nullptr;
@@ -241,7 +248,7 @@ public:
       return;
 
     uint8_t resByte = 0;
-    int ret = receiveBytes(resByte, 0);
+    int ret = receiveBytes(resByte, 100); // 超时100ms：接收子线程可按标志退出
     if (ret == 0) {
       if (resByte == USB_FRAME_HEAD && !serialStr.start) // 监听帧头
       {
@@ -282,6 +289,7 @@ public:
         {
           memcpy(serialStr.buffFinish, serialStr.buffRead,
                  USB_FRAME_LENMAX); // 储存接收的数据
+          tracer.instant("uart rx", Profiler::ticks(), serialStr.buffFinish[1]); // 接收帧（参数：地址）
           dataTransform();
         }
 
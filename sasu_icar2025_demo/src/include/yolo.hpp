@@ -0,0 +1,338 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file yolo.hpp
+ * @author HC
+ * @brief YOLOv3后处理（进程内）：检测头解码+分类别NMS，替代post.onnx+PPNC NMS
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 计算步骤：
+ *                  [01] 目标置信度提前拒绝：在logit域比较阈值（无需sigmoid），连续内存整平面SIMD比较+位掩码压缩
+ *                  [02] 通过的候选框解码（与post.onnx一致：中心偏移/网格、锚框/输入尺寸、×原图尺寸、裁剪到图像内）
+ *                  [03] 类别得分=sigmoid(cls)×目标置信度，仅保留大于得分阈值的（类别, 候选框）
+ *                  [04] 分类别排序（得分降序，同分按候选序号）→取前nmsTopK→贪心NMS（像素坐标IoU，宽高+1）
+ *                  [05] 全部类别合计超过keepTopK时按得分截取，输出按类别升序、类别内得分降序
+ *       输出格式同PPNC NMS：每行[类别, 得分, x1, y1, x2, y2]
+ *       参数取自模型文件：锚框/目标阈值0.005（post.onnx），得分阈值0.01/IoU阈值0.45/nmsTopK 1000/keepTopK 100（nms.tar）
+ *       所有缓冲区在构造时按最大候选数分配，帧间无内存分配
+ *       指令集（[01]）：AVX2(8个) / SSE2(4个) / NEON-aarch64(4个) / 标量兜底；
+ *       sigmoid/exp只作用于通过[01]的少量候选框，保持标量计算（与post.onnx计算方式一致）
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+class YoloPost
+{
+public:
+    float confThreshold = 0.005f; // 目标置信度阈值（post.onnx）
+    float scoreThreshold = 0.01f; // NMS得分阈值
+    float nmsThreshold = 0.45f;   // NMS交并比阈值
+    int nmsTopK = 1000;           // 单类别参与NMS的最大候选数
+    int keepTopK = 100;           // 最大输出框数
+    std::vector<float> output;    // 检测结果：每行[类别, 得分, x1, y1, x2, y2]
+    int count = 0;                // 检测结果数
+
+    /**
+     * @brief 初始化
+     *
+     * @param shapes 检测头尺寸（NCHW，io_paddle.json中OUTPUT顺序）
+     * @param sizeInput 模型输入尺寸
+     */
+    YoloPost(const std::vector<std::vector<int64_t>> &shapes, cv::Size sizeInput)
+    {
+        int total = 0, planeMax = 0;
+        for (size_t i = 0; i < shapes.size(); i++)
+        {
+            Head head;
+            head.channels = shapes[i][1];
+            head.height = shapes[i][2];
+            head.width = shapes[i][3];
+            head.stride = sizeInput.height / head.height;
+            head.offset = total;
+            for (int a = 0; a < ANCHOR_NUM; a++) // 步长32/16/8分别对应大/中/小锚框
+            {
+                int index = anchorIndex(head.stride) * ANCHOR_NUM + a;
+                head.anchors[a][0] = ANCHORS[index][0];
+                head.anchors[a][1] = ANCHORS[index][1];
+            }
+            total += ANCHOR_NUM * head.height * head.width;
+            planeMax = std::max(planeMax, head.height * head.width);
+            heads.push_back(head);
+        }
+        classNum = heads.empty() ? 0 : heads[0].channels / ANCHOR_NUM - 5;
+
+        boxes.resize(total * 5);
+        passed.resize(planeMax);
+        candidates.resize(classNum);
+        for (int c = 0; c < classNum; c++)
+            candidates[c].reserve(total);
+        kept.reserve(classNum * nmsTopK);
+        output.resize(keepTopK * 6);
+    }
+
+    /**
+     * @brief 检测头解码+NMS
+     *
+     * @param outputs 检测头数据（NCHW，与构造时顺序一致）
+     * @param imShape 模型输入尺寸（同post.onnx输入im_shape）
+     * @param scaleFactor 缩放系数（同post.onnx输入scale_factor）
+     */
+    void process(const float *const *outputs, const float imShape[2], const float scaleFactor[2])
+    {
+        // 原图尺寸：同post.onnx，float除法后截断取整
+        const float imgH = (float)(int)(imShape[0] / scaleFactor[0]);
+        const float imgW = (float)(int)(imShape[1] / scaleFactor[1]);
+        const float threshold = std::max(confThreshold, scoreThreshold); // 目标置信度不超过该值时，全部类别得分均不超过得分阈值
+        const float logit = std::log(threshold / (1 - threshold));
+
+        for (int c = 0; c < classNum; c++)
+            candidates[c].clear();
+
+        for (size_t i = 0; i < heads.size(); i++)
+        {
+            const Head &head = heads[i];
+            const int plane = head.height * head.width;
+            for (int a = 0; a < ANCHOR_NUM; a++)
+            {
+                const float *data = outputs[i] + (size_t)a * (5 + classNum) * plane;
+                const float *conf = data + 4 * plane;
+                const float anchorW = head.anchors[a][0] / (float)(head.width * head.stride);
+                const float anchorH = head.anchors[a][1] / (float)(head.height * head.stride);
+
+                // [01] 目标置信度提前拒绝：压缩出通过的网格序号
+                const int number = compress(conf, plane, logit, passed.data());
+
+                for (int n = 0; n < number; n++)
+                {
+                    // [02] 候选框解码
+                    const int p = passed[n];
+                    const int index = head.offset + a * plane + p;
+                    const float gridX = p % head.width, gridY = p / head.width;
+                    const float x = (sigmoid(data[p]) + gridX) / head.width;
+                    const float y = (sigmoid(data[plane + p]) + gridY) / head.height;
+                    const float w = std::exp(data[2 * plane + p]) * anchorW / 2;
+                    const float h = std::exp(data[3 * plane + p]) * anchorH / 2;
+                    float *box = &boxes[index * 5];
+                    box[0] = std::max((x - w) * imgW, 0.f);
+                    box[1] = std::max((y - h) * imgH, 0.f);
+                    box[2] = std::min((x + w) * imgW, imgW - 1);
+                    box[3] = std::min((y + h) * imgH, imgH - 1);
+
+                    box[4] = area(box);
+
+                    // [03] 类别得分：logit域预筛（留余量，边界处仍按实际得分判定）
+                    const float objectness = sigmoid(conf[p]);
+                    const float ratio = scoreThreshold / objectness;
+                    const float clsLogit = ratio < 1 ? std::log(ratio / (1 - ratio)) - 1e-3f : INFINITY;
+                    for (int c = 0; c < classNum; c++)
+                    {
+                        const float cls = data[(5 + c) * plane + p];
+                        if (cls < clsLogit)
+                            continue;
+                        float score = sigmoid(cls) * objectness;
+                        if (score > scoreThreshold)
+                            candidates[c].push_back({score, index});
+                    }
+                }
+            }
+        }
+
+        // [04] 分类别NMS
+        kept.clear();
+        for (int c = 0; c < classNum; c++)
+        {
+            std::vector<Candidate> &list = candidates[c];
+            std::sort(list.begin(), list.end(), descend);
+            if ((int)list.size() > nmsTopK)
+                list.resize(nmsTopK);
+
+            // 类别内保留数达到keepTopK后，后续框得分更低，不会进入最终输出
+            const size_t start = kept.size();
+            for (size_t i = 0; i < list.size() && (int)(kept.size() - start) < keepTopK; i++)
+            {
+                bool keep = true;
+                for (size_t k = start; k < kept.size() && keep; k++)
+                    keep = overlap(&boxes[list[i].index * 5], &boxes[kept[k].index * 5]) <= nmsThreshold;
+                if (keep)
+                    kept.push_back({list[i].score, list[i].index, c});
+            }
+        }
+
+        // [05] 合计截取+输出
+        if ((int)kept.size() > keepTopK)
+        {
+            std::sort(kept.begin(), kept.end(), [](const Detected &a, const Detected &b)
+                      { return a.score != b.score ? a.score > b.score : (a.label != b.label ? a.label < b.label : a.index < b.index); });
+            kept.resize(keepTopK);
+            std::sort(kept.begin(), kept.end(), [](const Detected &a, const Detected &b)
+                      { return a.label != b.label ? a.label < b.label : (a.score != b.score ? a.score > b.score : a.index < b.index); });
+        }
+
+        count = kept.size();
+        for (int i = 0; i < count; i++)
+        {
+            float *row = &output[i * 6];
+            const float *box = &boxes[kept[i].index * 5];
+            row[0] = kept[i].label;
+            row[1] = kept[i].score;
+            row[2] = box[0];
+            row[3] = box[1];
+            row[4] = box[2];
+            row[5] = box[3];
+        }
+    }
+
+private:
+    static constexpr int ANCHOR_NUM = 3;      // 每个检测头的锚框数
+    static constexpr float ANCHORS[9][2] = {  // 锚框（像素，模型输入尺度）
+        {10, 13}, {16, 30}, {33, 23},         // 步长8
+        {30, 61}, {62, 45}, {59, 119},        // 步长16
+        {116, 90}, {156, 198}, {373, 326}};   // 步长32
+
+    /**
+     * @brief 检测头
+     *
+     */
+    struct Head
+    {
+        int channels;         // 通道数：锚框数×(5+类别数)
+        int height;           // 网格行数
+        int width;            // 网格列数
+        int stride;           // 下采样步长
+        int offset;           // 首个候选框序号
+        float anchors[3][2];  // 锚框
+    };
+
+    /**
+     * @brief 候选框（单类别）
+     *
+     */
+    struct Candidate
+    {
+        float score; // 得分
+        int index;   // 候选框序号
+    };
+
+    /**
+     * @brief NMS保留的检测框
+     *
+     */
+    struct Detected
+    {
+        float score; // 得分
+        int index;   // 候选框序号
+        int label;   // 类别
+    };
+
+    int classNum = 0;                               // 类别数
+    std::vector<Head> heads;                        // 检测头
+    std::vector<float> boxes;                       // 候选框[x1, y1, x2, y2, 面积]（仅通过目标置信度的候选框有效）
+    std::vector<int> passed;                        // 通过目标置信度的网格序号
+    std::vector<std::vector<Candidate>> candidates; // 分类别候选框
+    std::vector<Detected> kept;                     // NMS保留的检测框
+
+    static float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+    /**
+     * @brief 阈值压缩：按序输出大于阈值的元素序号（SIMD比较得位掩码，逐位取序号；整组未通过时直接跳过）
+     *
+     * @param data 输入（连续内存）
+     * @param size 元素数
+     * @param limit 阈值
+     * @param index 输出序号（容量不小于size）
+     * @return int 通过的元素数
+     */
+    static int compress(const float *data, int size, float limit, int *index)
+    {
+        int number = 0, p = 0;
+#if defined(__AVX2__)
+        const __m256 vlimit = _mm256_set1_ps(limit);
+        for (; p + 8 <= size; p += 8)
+        {
+            unsigned mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + p), vlimit, _CMP_GT_OQ));
+            for (; mask; mask &= mask - 1)
+                index[number++] = p + __builtin_ctz(mask);
+        }
+#elif defined(__SSE2__)
+        const __m128 vlimit = _mm_set1_ps(limit);
+        for (; p + 4 <= size; p += 4)
+        {
+            unsigned mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(data + p), vlimit));
+            for (; mask; mask &= mask - 1)
+                index[number++] = p + __builtin_ctz(mask);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        static const uint32_t weights[4] = {1, 2, 4, 8};
+        const uint32x4_t vweight = vld1q_u32(weights);
+        const float32x4_t vlimit = vdupq_n_f32(limit);
+        for (; p + 4 <= size; p += 4)
+        {
+            unsigned mask = vaddvq_u32(vandq_u32(vcgtq_f32(vld1q_f32(data + p), vlimit), vweight));
+            for (; mask; mask &= mask - 1)
+                index[number++] = p + __builtin_ctz(mask);
+        }
+#endif
+        for (; p < size; p++) // 标量兜底/尾部：无分支压缩
+        {
+            index[number] = p;
+            number += data[p] > limit;
+        }
+        return number;
+    }
+
+    static bool descend(const Candidate &a, const Candidate &b)
+    {
+        return a.score != b.score ? a.score > b.score : a.index < b.index;
+    }
+
+    static int anchorIndex(int stride)
+    {
+        return stride >= 32 ? 2 : (stride >= 16 ? 1 : 0);
+    }
+
+    /**
+     * @brief 交并比（像素坐标：宽高+1，同Paddle multiclass_nms的normalized=false）
+     *
+     */
+    static float overlap(const float *a, const float *b)
+    {
+        if (b[0] > a[2] || b[2] < a[0] || b[1] > a[3] || b[3] < a[1])
+            return 0.f;
+        const float w = std::min(a[2], b[2]) - std::max(a[0], b[0]) + 1;
+        const float h = std::min(a[3], b[3]) - std::max(a[1], b[1]) + 1;
+        const float inter = w * h;
+        return inter / (a[4] + b[4] - inter);
+    }
+
+    static float area(const float *box)
+    {
+        if (box[2] < box[0] || box[3] < box[1])
+            return 0.f;
+        return (box[2] - box[0] + 1) * (box[3] - box[1] + 1);
+    }
+};
\ No newline at end of file
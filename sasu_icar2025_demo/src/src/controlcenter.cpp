@@ -51,7 +51,7 @@ public:
     sigmaCenter = 0;
     controlCenter = COLSIMAGE / 2;
     centerEdge.clear();
-    vector<POINT> v_center(4); // 三阶贝塞尔曲线
+    FrameVector<POINT> v_center(4); // 三阶贝塞尔曲线（单帧内存池）
     style = "STRIGHT";
 
     // 边缘斜率重计算（边缘修正之后）
@@ -98,7 +98,7 @@ public:
            track.pointsEdgeRight[track.pointsEdgeRight.size() * 0.9].y) /
               2};
 
-      centerEdge = Bezier(0.03, v_center);
+      Bezier<3>(0.03, v_center, centerEdge);
 
       style = "STRIGHT";
     }
@@ -110,7 +110,7 @@ public:
               track.pointsEdgeLeft[0].x - track.pointsEdgeRight[0].x >
                   ROWSIMAGE / 2)) {
       style = "RIGHT";
-      centerEdge = centerCompute(track.pointsEdgeLeft, 0);
+      centerCompute(track.pointsEdgeLeft, 0, centerEdge);
     }
     // 右单边
     else if ((track.pointsEdgeRight.size() > 0 &&
@@ -120,7 +120,7 @@ public:
               track.pointsEdgeRight[0].x - track.pointsEdgeLeft[0].x >
                   ROWSIMAGE / 2)) {
       style = "LEFT";
-      centerEdge = centerCompute(track.pointsEdgeRight, 1);
+      centerCompute(track.pointsEdgeRight, 1, centerEdge);
     } else if (track.pointsEdgeLeft.size() > 10 &&
                track.pointsEdgeRight.size() == 0) // 左单边
     {
@@ -143,7 +143,7 @@ public:
                       COLSIMAGE - 1) /
                          2};
 
-      centerEdge = Bezier(0.02, v_center);
+      Bezier<3>(0.02, v_center, centerEdge);
 
       style = "RIGHT";
     } else if (track.pointsEdgeLeft.size() == 0 &&
@@ -164,7 +164,7 @@ public:
                      track.pointsEdgeRight[track.pointsEdgeRight.size() - 1].y /
                          2};
 
-      centerEdge = Bezier(0.02, v_center);
+      Bezier<3>(0.02, v_center, centerEdge);
 
       style = "LEFT";
     }
@@ -191,7 +191,7 @@ public:
 
     // 控制率计算
     if (centerEdge.size() > 20) {
-      vector<POINT> centerV;
+      centerV.clear();
       int filt = centerEdge.size() / 5;
       for (size_t i = filt; i < centerEdge.size() - filt;
            i++) // 过滤中心点集前后1/5的诱导性
@@ -210,7 +210,7 @@ public:
    * @return true
    * @return false
    */
-  bool derailmentCheck(Tracking track) {
+  bool derailmentCheck(const Tracking &track) {
     if (track.pointsEdgeLeft.size() < 30 &&
         track.pointsEdgeRight.size() < 30) // 防止车辆冲出赛道
     {
@@ -233,7 +233,7 @@ public:
    *
    * @param centerImage 需要叠加显示的图像
    */
-  void drawImage(Tracking track, Mat &centerImage) {
+  void drawImage(const Tracking &track, Mat &centerImage) {
     // 赛道边缘绘制
     for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++) {
       circle(centerImage,
@@ -280,13 +280,14 @@ private:
   int countOutlineA = 0; // 车辆脱轨检测计数器
   int countOutlineB = 0; // 车辆脱轨检测计数器
   string style = "";     // 赛道类型
+  vector<POINT> centerV; // 过滤后的中心点集（复用内存）
   /**
    * @brief 搜索十字赛道突变行（左下）
    *
    * @param pointsEdgeLeft
    * @return uint16_t
    */
-  uint16_t searchBreakLeftDown(vector<POINT> pointsEdgeLeft) {
+  uint16_t searchBreakLeftDown(const EdgePoints &pointsEdgeLeft) {
     uint16_t counter = 0;
 
     for (size_t i = 0; i < pointsEdgeLeft.size() - 10; i++) {
@@ -308,7 +309,7 @@ private:
    * @param pointsEdgeRight
    * @return uint16_t
    */
-  uint16_t searchBreakRightDown(vector<POINT> pointsEdgeRight) {
+  uint16_t searchBreakRightDown(const EdgePoints &pointsEdgeRight) {
     uint16_t counter = 0;
 
     for (size_t i = 0; i < pointsEdgeRight.size() - 10; i++) // 寻找左边跳变点
@@ -330,15 +331,14 @@ private:
    *
    * @param pointsEdge 赛道边缘点集
    * @param side 单边类型：左边0/右边1
-   * @return vector<POINT>
+   * @param center 控制中心集合（输出）
    */
-  vector<POINT> centerCompute(vector<POINT> pointsEdge, int side) {
+  void centerCompute(const EdgePoints &pointsEdge, int side,
+                     vector<POINT> &center) {
     int step = 4;                    // 间隔尺度
     int offsetWidth = COLSIMAGE / 2; // 首行偏移量
     int offsetHeight = 0;            // 纵向偏移量
 
-    vector<POINT> center; // 控制中心集合
-
     if (side == 0) // 左边缘
     {
       uint16_t counter = 0, rowStart = 0;
@@ -397,8 +397,7 @@ private:
       }
     }
 
-    return center;
-    // return Bezier(0.2,center);
+    // center = Bezier(0.2,center);
   }
 
 };
\ No newline at end of file
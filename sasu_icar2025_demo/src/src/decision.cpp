@@ -0,0 +1,294 @@
+#pragma once
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file decision.cpp
+ * @author HC
+ * @brief 场景决策：赛道识别→特殊场景检测→控制中心拟合→运动控制
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 决策层不直接操作串口，每帧输出一条控制指令（Command），由执行层下发：
+ *       顺序模式（调试）与流水线模式共用同一套场景处理流程
+ */
+
+#include "../include/common.hpp"
+#include "../include/detection.hpp"
+#include "../include/features.hpp"
+#include "../include/profiler.hpp"
+#include "controlcenter.cpp"
+#include "detection/bridge.cpp"
+#include "detection/obstacle.cpp"
+#include "detection/catering.cpp"
+#include "detection/layby.cpp"
+#include "detection/parking.cpp"
+#include "detection/crosswalk.cpp"
+#include "motion.cpp"
+#include "recognition/crossroad.cpp"
+#include "recognition/ring.cpp"
+#include "recognition/tracking.cpp"
+
+using namespace std;
+using namespace cv;
+
+/**
+ * @brief 提示音效
+ *
+ */
+enum Sound
+{
+    SoundNone = 0, // 无
+    SoundOk,       // 确认
+    SoundDing      // 提示
+};
+
+/**
+ * @brief 单帧控制指令（决策层→执行层）
+ *
+ */
+struct Command
+{
+    uint64_t seq = 0;                 // 帧序号
+    Scene scene = Scene::NormalScene; // 当前帧场景
+    bool control = false;             // 运动控制使能
+    float speed = 0;                  // 速度：m/s
+    uint16_t servoPwm = PWMSERVOMID;  // 舵机PWM
+    Sound soundDetect = SoundNone;    // 场景检测音效（运动控制前）
+    Sound soundScene = SoundNone;     // 场景切换音效（运动控制后）
+    bool exit = false;                // 停车并退出程序
+    int age = 0;                      // AI结果帧龄（异步推理）
+    uint64_t stamp = 0;               // 采集时刻（Profiler时钟，整帧耗时统计）
+};
+
+class Decision
+{
+public:
+    Tracking tracking;        // 赛道识别类
+    Crossroad crossroad;      // 十字道路识别类
+    Ring ring;                // 环岛识别类
+    Bridge bridge;            // 坡道区检测类
+    Catering catering;        // 快餐店检测类
+    Obstacle obstacle;        // 障碍区检测类
+    Layby layby;              // 临时停车区检测类
+    Parking parking;          // 充电停车场检测类
+    StopArea stopArea;        // 停车区识别与路径规划类
+    ControlCenter ctrlCenter; // 控制中心计算类
+    LineFeatures features;    // 单帧直线特征缓存（快餐店/临时停车区/充电停车场共享）
+
+    Decision(Motion &motion) : motion(motion) {};
+
+    /**
+     * @brief 赛道识别
+     *
+     * @param imgBinary 二值化图像
+     */
+    void trackRecognition(Mat &imgBinary)
+    {
+        tracking.rowCutUp = motion.params.rowCutUp;         // 图像顶部切行（前瞻距离）
+        tracking.rowCutBottom = motion.params.rowCutBottom; // 图像底部切行（盲区距离）
+        tracking.incremental = motion.params.trackIncremental; // 增量搜索使能
+        tracking.searchWindow = motion.params.trackWindow;     // 增量搜索窗口半宽
+        ProfileScope profile(PROFILE_TRACKING);
+        tracking.trackRecognition(imgBinary);
+    }
+
+    /**
+     * @brief 场景识别与运动控制（需先完成赛道识别）
+     *
+     * @param imgBinary 二值化图像
+     * @param predict AI检测结果
+     * @param age AI检测结果帧龄：当前帧与推理帧的序号差（同步推理为0）
+     * @return Command 本帧控制指令
+     *
+     * @note 场景检测按类别出现标志分发：检测器空闲（无激活的状态机/待确认计数）且本帧无其触发类别时跳过，
+     *       跳过等价于检测器本帧返回false
+     */
+    Command process(Mat &imgBinary, PredictResults &predict, int age = 0)
+    {
+        Command cmd;
+        cmd.age = age;
+
+        // 过期的AI结果不再参与场景检测
+        const PredictResults &results = age > motion.params.detectionAge ? resultsExpired : predict;
+        features.houghBand = motion.params.houghBand; // 窄带霍夫检测使能
+        features.frame(imgBinary); // 直线特征按需计算，帧内复用
+
+        //[05] 停车区检测
+        if (motion.params.stop)
+        {
+            ProfileScope profile(PROFILE_STOP);
+            if ((!stopArea.idle() || results.any(StopArea::LABELS)) && stopArea.process(results))
+            {
+                scene = Scene::StopScene;
+                if (stopArea.countExit > 20)
+                {
+                    cmd.scene = scene;
+                    cmd.exit = true; // 控制车辆停止运动并退出
+                    return cmd;
+                }
+            }
+        }
+
+        //[06] 快餐店检测
+        if ((scene == Scene::NormalScene || scene == Scene::CateringScene) && motion.params.catering)
+        {
+            ProfileScope profile(PROFILE_CATERING);
+            if ((!catering.idle() || results.any(Catering::LABELS)) &&
+                catering.process(tracking, features, results)) // 传入二值化图像的直线特征进行再处理
+                scene = Scene::CateringScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[07] 临时停车区检测
+        if ((scene == Scene::NormalScene || scene == Scene::LaybyScene) && motion.params.catering)
+        {
+            ProfileScope profile(PROFILE_LAYBY);
+            if ((!layby.idle() || results.any(Layby::LABELS)) &&
+                layby.process(tracking, features, results)) // 传入二值化图像的直线特征进行再处理
+                scene = Scene::LaybyScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[08] 充电停车场检测
+        if ((scene == Scene::NormalScene || scene == Scene::ParkingScene) && motion.params.parking)
+        {
+            ProfileScope profile(PROFILE_PARKING);
+            if (parking.idle() && !results.any(Parking::LABELS))
+            {
+                parking.skip();
+                scene = Scene::NormalScene;
+            }
+            else if (parking.process(tracking, features, results)) // 传入二值化图像的直线特征进行再处理
+                scene = Scene::ParkingScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[09] 坡道区检测
+        if ((scene == Scene::NormalScene || scene == Scene::BridgeScene) && motion.params.bridge)
+        {
+            ProfileScope profile(PROFILE_BRIDGE);
+            if ((!bridge.idle() || results.any(Bridge::LABELS)) && bridge.process(tracking, results))
+                scene = Scene::BridgeScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[10] 障碍区检测
+        if ((scene == Scene::NormalScene || scene == Scene::ObstacleScene) && motion.params.obstacle)
+        {
+            ProfileScope profile(PROFILE_OBSTACLE);
+            if ((!obstacle.idle() || results.any(Obstacle::LABELS)) && obstacle.process(tracking, results))
+            {
+                cmd.soundDetect = SoundDing; // 祖传提示音效
+                scene = Scene::ObstacleScene;
+            }
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[11] 十字道路识别与路径规划
+        if ((scene == Scene::NormalScene || scene == Scene::CrossScene) && motion.params.cross)
+        {
+            ProfileScope profile(PROFILE_CROSS);
+            if (crossroad.crossRecognition(tracking))
+                scene = Scene::CrossScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[12] 环岛识别与路径规划
+        if ((scene == Scene::NormalScene || scene == Scene::RingScene) && motion.params.ring && catering.noRing)
+        {
+            ProfileScope profile(PROFILE_RING);
+            if (ring.process(tracking, imgBinary))
+                scene = Scene::RingScene;
+            else
+                scene = Scene::NormalScene;
+        }
+
+        //[13] 车辆控制中心拟合
+        {
+            ProfileScope profile(PROFILE_FITTING);
+            ctrlCenter.fitting(tracking);
+        }
+        cmd.scene = scene;
+
+        if (scene != Scene::ParkingScene)
+        {
+            if (ctrlCenter.derailmentCheck(tracking)) // 车辆冲出赛道检测（保护车辆）
+            {
+                cmd.exit = true;
+                return cmd;
+            }
+        }
+
+        //[14] 运动控制(速度+方向)
+        if (!motion.params.debug && countInit > 30) // 非调试模式下
+        {
+            // 触发停车
+            if ((catering.stopEnable && scene == Scene::CateringScene) || (layby.stopEnable && scene == Scene::LaybyScene) || (parking.step == parking.ParkStep::stop))
+                motion.speed = 0;
+            else if (scene == Scene::CateringScene)
+                motion.speed = motion.params.speedCatering;
+            else if (scene == Scene::LaybyScene)
+                motion.speed = motion.params.speedLayby;
+            else if (scene == Scene::ParkingScene && parking.step == parking.ParkStep::trackout) // 倒车出库
+                motion.speed = -motion.params.speedDown;
+            else if (scene == Scene::ParkingScene) // 减速
+                motion.speed = motion.params.speedParking;
+            else if (scene == Scene::BridgeScene) // 坡道速度
+                motion.speed = motion.params.speedBridge;
+            else if (scene == Scene::ObstacleScene) // 危险区速度
+                motion.speed = motion.params.speedObstacle;
+            else if (scene == Scene::RingScene) // 环岛速度
+                motion.speed = motion.params.speedRing;
+            else if (scene == Scene::StopScene)
+                motion.speed = motion.params.speedDown;
+            else
+                motion.speedCtrl(true, false, ctrlCenter); // 车速控制
+
+            motion.poseCtrl(ctrlCenter.controlCenter); // 姿态控制（舵机）
+
+            cmd.control = true;
+            cmd.speed = motion.speed;
+            cmd.servoPwm = motion.servoPwm;
+        }
+        else
+            countInit++;
+
+        //[16] 状态复位
+        if (sceneLast != scene)
+        {
+            if (scene == Scene::NormalScene)
+                cmd.soundScene = SoundDing; // 祖传提示音效
+            else
+                cmd.soundScene = SoundOk; // 祖传提示音效
+        }
+        sceneLast = scene; // 记录当前状态
+        if (scene != Scene::BridgeScene) // 坡道区之外的场景每帧重新判定
+            scene = Scene::NormalScene;
+
+        return cmd;
+    }
+
+private:
+    Motion &motion;                       // 运动控制类
+    Scene scene = Scene::NormalScene;     // 初始化场景：常规道路
+    Scene sceneLast = Scene::NormalScene; // 记录上一次场景状态
+    int countInit = 0;                    // 初始化计数器
+    PredictResults resultsExpired;        // AI结果过期时的空结果
+};
\ No newline at end of file
@@ -18,6 +18,8 @@
  * @date 2025-02-28
  * @copyright Copyright (c) 2024
  *
+ * @note 用法：./detection [compare]
+ *       compare：同一NNA输出分别经post.onnx+PPNC NMS与内置YOLOv3解码+NMS，逐帧比对检测结果并统计后处理耗时
  */
 #include "../include/common.hpp"     //公共类方法文件
 #include "../include/detection.hpp"  //百度Paddle框架移动端部署
@@ -26,20 +28,99 @@
 #include <iostream>
 #include <opencv2/highgui.hpp> //OpenCV终端部署
 #include <opencv2/opencv.hpp>  //OpenCV终端部署
+#include <chrono>
 #include <signal.h>
 #include <unistd.h>
 
 using namespace std;
 using namespace cv;
 
+#ifdef WITH_PPNC
+/**
+ * @brief 后处理比对：检测框逐一匹配（类别相同、得分与坐标误差在容差内）
+ *
+ * @return int 未匹配的检测框数
+ */
+int compareResults(const PredictResults &reference, const PredictResults &results) {
+  int mismatch = abs((int)reference.size() - (int)results.size());
+  for (const PredictResult &a : reference) {
+    bool matched = false;
+    for (const PredictResult &b : results) {
+      if (a.type == b.type && fabs(a.score - b.score) < 1e-3 &&
+          abs(a.x - b.x) <= 1 && abs(a.y - b.y) <= 1 &&
+          abs(a.width - b.width) <= 1 && abs(a.height - b.height) <= 1) {
+        matched = true;
+        break;
+      }
+    }
+    if (!matched)
+      mismatch++;
+  }
+  return mismatch;
+}
+
+/**
+ * @brief 后处理比对模式：遍历视频，统计两种后处理的结果差异与耗时
+ *
+ */
+int comparePost(shared_ptr<Detection> &detection, VideoCapture &capture) {
+  auto ppnc = dynamic_pointer_cast<BackendPPNC>(detection->backend);
+  if (!ppnc) {
+    printf("compare requires backend: ppnc\n");
+    return -1;
+  }
+
+  Mat img;
+  int frames = 0, mismatch = 0, boxes = 0;
+  double timeOnnx = 0, timeNative = 0;
+  PredictResults reference;
+  while (capture.read(img)) {
+    ppnc->preprocess(img);
+    ppnc->runNna();
+
+    auto start = chrono::steady_clock::now();
+    ppnc->nativePost = false;
+    ppnc->runPost();
+    detection->render();
+    auto middle = chrono::steady_clock::now();
+    reference = detection->results;
+
+    ppnc->nativePost = true;
+    ppnc->runPost();
+    detection->render();
+    auto end = chrono::steady_clock::now();
+
+    timeOnnx += chrono::duration<double, micro>(middle - start).count();
+    timeNative += chrono::duration<double, micro>(end - middle).count();
+    mismatch += compareResults(reference, detection->results);
+    boxes += reference.size();
+    frames++;
+  }
+
+  if (frames == 0) {
+    printf("no frames!!!\n");
+    return -1;
+  }
+  printf("[post] frames: %d | boxes: %d | mismatch: %d\n", frames, boxes, mismatch);
+  printf("[post] onnx+nms: %.1fus | native: %.1fus | speedup: %.2fx\n",
+         timeOnnx / frames, timeNative / frames, timeOnnx / timeNative);
+  return mismatch ? -1 : 0;
+}
+#endif
+
 int main(int argc, char const *argv[]) {
   Preprocess preprocess;    // 图像预处理类
   Motion motion;            // 运动控制类
   VideoCapture capture;     // Opencv相机类
+  const bool compare = argc > 1 && string(argv[1]) == "compare"; // 后处理比对：两种后处理均需加载
 
   // 目标检测类(AI模型文件)
-  shared_ptr<Detection> detection = make_shared<Detection>(motion.params.model);
+  shared_ptr<Detection> detection = make_shared<Detection>(motion.params.model, motion.params.backend,
+                                                          motion.params.detectionFile, motion.params.recordDetection,
+                                                          motion.params.nativePost && !compare);
   detection->score = motion.params.score; // AI检测置信度
+  detection->keyframeMax = motion.params.keyframeMax;     // AI关键帧最大间隔
+  detection->keyframeDecay = motion.params.keyframeDecay; // 传播帧置信度衰减
 
   // USB摄像头初始化
   capture = VideoCapture("../res/samples/sample.mp4"); // 打开摄像头
@@ -51,6 +132,11 @@ int main(int argc, char const *argv[]) {
   capture.set(CAP_PROP_FRAME_HEIGHT, ROWSIMAGE); // 设置图像分辨率
   capture.set(CAP_PROP_FPS, 30);                 // 设置帧率
 
+#ifdef WITH_PPNC
+  if (compare) // 后处理比对
+    return comparePost(detection, capture);
+#endif
+
   // 初始化参数
   Mat img;
 
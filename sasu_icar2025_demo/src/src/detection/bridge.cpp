@@ -36,7 +36,15 @@ using namespace std;
 class Bridge
 {
 public:
-    bool process(Tracking &track, vector<PredictResult> predict)
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_BRIDGE); // 触发类别
+
+    /**
+     * @brief 场景空闲：未进入坡道且无待确认的AI标志（本帧无触发类别时可跳过检测）
+     *
+     */
+    bool idle(void) const { return !bridgeEnable && counterRec == 0; }
+
+    bool process(Tracking &track, const PredictResults &predict)
     {
         if (bridgeEnable) // 进入坡道
         {
@@ -57,9 +65,9 @@ public:
         }
         else // 检测坡道
         {
-            for (size_t i = 0; i < predict.size(); i++)
+            for (const PredictResult &result : predict.bucket(LABEL_BRIDGE))
             {
-                if (predict[i].type == LABEL_BRIDGE && predict[i].score > 0.6 && (predict[i].y + predict[i].height) > ROWSIMAGE * 0.32)
+                if (result.score > 0.6 && (result.y + result.height) > ROWSIMAGE * 0.32)
                 {
                     counterRec++;
                     break;
@@ -91,7 +99,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(Tracking track, Mat &image)
+    void drawImage(const Tracking &track, Mat &image)
     {
         // 赛道边缘
         for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++)
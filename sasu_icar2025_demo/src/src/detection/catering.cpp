@@ -27,6 +27,7 @@
 #include <opencv2/opencv.hpp>
 #include "../../include/common.hpp"
 #include "../../include/detection.hpp"
+#include "../../include/features.hpp"
 #include "../recognition/tracking.cpp"
 
 using namespace cv;
@@ -39,29 +40,27 @@ public:
     bool stopEnable = false;        // 停车使能标志
     bool noRing = false;            // 用来区分环岛路段
 
-    bool process(Tracking &track, Mat &image, vector<PredictResult> predict)
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_BURGER); // 触发类别
+
+    /**
+     * @brief 场景空闲：未进入快餐店且无待确认的AI标志（本帧无触发类别时可跳过检测）
+     *
+     */
+    bool idle(void) const { return !cateringEnable && counterRec == 0; }
+
+    bool process(Tracking &track, LineFeatures &features, const PredictResults &predict)
     {
         if (cateringEnable) // 进入岔路
         {   
             if (!stopEnable && turning)
             {
-                for (size_t i = 0; i < predict.size(); i++)
+                for (const PredictResult &result : predict.bucket(LABEL_BURGER))
                 {
-                    if (predict[i].type == LABEL_BURGER)
-                    {
-                        burgerY = predict[i].y;   // 计算汉堡最高高度
-                    }
+                    burgerY = result.y;   // 计算汉堡最高高度
                 }
 
-                // 边缘检测
-                Mat edges;
-                Mat blurred;
-                GaussianBlur(image, blurred, Size(3, 3), 0);  // 添加高斯模糊预处理
-                Canny(blurred, edges, 30, 150, 3);  // 调整Canny参数，使用3x3 Sobel算子
-
-                // 霍夫变换检测直线
-                vector<Vec4i> lines;
-                HoughLinesP(edges, lines, 1, CV_PI / 180, 50, 50, 10);
+                // 边缘检测（高斯模糊+Canny，3x3 Sobel算子）+霍夫变换检测直线：帧内共享缓存
+                const vector<Vec4i> &lines = features.lines({true, 30, 150, 3}, {1, CV_PI / 180, 50, 50, 10});
 
                 // 遍历检测到的直线
                 for (size_t i = 0; i < lines.size(); i++) {
@@ -136,13 +135,13 @@ public:
         }
         else // 检测汉堡标志
         {
-            for (size_t i = 0; i < predict.size(); i++)
+            for (const PredictResult &result : predict.bucket(LABEL_BURGER))
             {
-                if (predict[i].type == LABEL_BURGER && predict[i].score > 0.4 && (predict[i].y + predict[i].height) > ROWSIMAGE * 0.3)
+                if (result.score > 0.4 && (result.y + result.height) > ROWSIMAGE * 0.3)
                 {
                     counterRec++;
                     noRing = true;
-                    if (predict[i].x < COLSIMAGE / 2)   // 汉堡在左侧
+                    if (result.x < COLSIMAGE / 2)   // 汉堡在左侧
                         burgerLeft = true;
                     else
                         burgerLeft = false;
@@ -175,7 +174,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(Tracking track, Mat &image)
+    void drawImage(const Tracking &track, Mat &image)
     {
         // 赛道边缘
         for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -55,6 +55,14 @@ private:
 public:
     uint16_t countExit = 0; // 程序退出计数器
     bool park = false;      // 停车标志
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_CROSSWALK); // 触发类别
+
+    /**
+     * @brief 场景空闲：斑马线检测阶段且无待确认的AI标志（本帧无触发类别时可跳过检测）
+     *
+     */
+    bool idle(void) const { return step == Step::det && countRec == 0; }
+
     /**
      * @brief 停车区AI识别与路径规划处理
      *
@@ -62,21 +70,18 @@ public:
      * @return true
      * @return false
      */
-    bool process(vector<PredictResult> predict)
+    bool process(const PredictResults &predict)
     {
         switch (step)
         {
         case Step::init: // 初始化：起点斑马线屏蔽
             countSes++;
-            for (size_t i = 0; i < predict.size(); i++)
+            for (const PredictResult &result : predict.bucket(LABEL_CROSSWALK)) // AI识别标志
             {
-                if (predict[i].type == LABEL_CROSSWALK) // AI识别标志
+                if ((result.y + result.height) > ROWSIMAGE * 0.2) // 标志距离计算
                 {
-                    if ((predict[i].y + predict[i].height) > ROWSIMAGE * 0.2) // 标志距离计算
-                    {
-                        countSes = 0;
-                        break;
-                    }
+                    countSes = 0;
+                    break;
                 }
             }
             if (countSes > 50)
@@ -87,15 +92,12 @@ public:
             break;
 
         case Step::det: // AI未识别
-            for (size_t i = 0; i < predict.size(); i++)
+            for (const PredictResult &result : predict.bucket(LABEL_CROSSWALK)) // AI识别标志
             {
-                if (predict[i].type == LABEL_CROSSWALK) // AI识别标志
+                if ((result.y + result.height) > ROWSIMAGE * 0.4) // 标志距离计算
                 {
-                    if ((predict[i].y + predict[i].height) > ROWSIMAGE * 0.4) // 标志距离计算
-                    {
-                        countRec++;
-                        break;
-                    }
+                    countRec++;
+                    break;
                 }
             }
             if (countRec) // 识别AI标志后开始场次计数
@@ -115,15 +117,12 @@ public:
 
         case Step::enable: // 场景使能: 检测斑马线标识丢失
             countSes++;
-            for (size_t i = 0; i < predict.size(); i++)
+            for (const PredictResult &result : predict.bucket(LABEL_CROSSWALK)) // AI识别标志
             {
-                if (predict[i].type == LABEL_CROSSWALK) // AI识别标志
+                if (result.y > ROWSIMAGE * 0.2) // 标志距离计算
                 {
-                    if (predict[i].y > ROWSIMAGE * 0.2) // 标志距离计算
-                    {
-                        countSes = 0;
-                        break;
-                    }
+                    countSes = 0;
+                    break;
                 }
             }
             if (countSes > 2)
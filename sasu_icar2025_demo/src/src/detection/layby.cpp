@@ -27,6 +27,7 @@
  #include <opencv2/opencv.hpp>
  #include "../../include/common.hpp"
  #include "../../include/detection.hpp"
+ #include "../../include/features.hpp"
  #include "../recognition/tracking.cpp"
 
 using namespace cv;
@@ -38,25 +39,29 @@ public:
 
     bool stopEnable = false;        // 停车使能标志
 
-    bool process(Tracking &track, Mat &image, vector<PredictResult> predict)
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_COMPANY) | PredictResults::bit(LABEL_SCHOOL); // 触发类别
+
+    /**
+     * @brief 场景空闲：未进入临时停车区且无待确认的AI标志（本帧无触发类别时可跳过检测）
+     *
+     */
+    bool idle(void) const { return !laybyEnable && counterRec == 0; }
+
+    bool process(Tracking &track, LineFeatures &features, const PredictResults &predict)
     {
         if (laybyEnable) // 进入临时停车状态
         {   
-            Mat edges;
-            Mat blurred;
-
             curtailTracking(track, leftEnable); // 缩减优化车道线（双车道→单车道）
-            // 直线检测
-            GaussianBlur(image, blurred, Size(3, 3), 0);  // 添加高斯模糊预处理
-            Canny(blurred, edges, 30, 150, 3);  // 调整Canny参数，使用3x3 Sobel算子
-
-            // 霍夫变换检测直线
-            vector<Vec4i> lines;
-            HoughLinesP(edges, lines, 1,        // rho
-                       CV_PI/180,              // theta
-                       25,                     // threshold：降低阈值
-                       40,                     // minLineLength：减小最小线段长度
-                       20);                    // maxLineGap：增大间隙容忍度
+            // 直线检测：高斯模糊+Canny（3x3 Sobel算子）+霍夫变换（只检测近水平方向），帧内共享缓存
+            // 结果复制到成员lines：下方排序不影响共享缓存
+            lines = features.lines({true, 30, 150, 3},
+                                   {1,         // rho
+                                    CV_PI/180, // theta
+                                    25,        // threshold：降低阈值
+                                    40,        // minLineLength：减小最小线段长度
+                                    20,        // maxLineGap：增大间隙容忍度
+                                    -26.6,     // 方向角范围：与下方斜率筛选（<0.5）一致
+                                    26.6});
             
             // 存储合并后的线段
             mergedLines.clear();
@@ -148,17 +153,24 @@ public:
             
         else // 检测标志
         {
-            for (size_t i = 0; i < predict.size(); i++)
+            bool found = false;
+            for (int type : {LABEL_COMPANY, LABEL_SCHOOL}) // 类别升序：与检测结果顺序一致
             {
-                if (((predict[i].type == LABEL_SCHOOL || predict[i].type == LABEL_COMPANY)  && predict[i].score > 0.6)  && (predict[i].y + predict[i].height) > ROWSIMAGE * 0.1)
+                for (const PredictResult &result : predict.bucket(type))
                 {
-                    counterRec++;
-                    if (predict[i].x < COLSIMAGE / 2)   // 标识牌在左侧
-                        leftEnable = true;
-                    else
-                        leftEnable = false;
-                    break;
+                    if (result.score > 0.6 && (result.y + result.height) > ROWSIMAGE * 0.1)
+                    {
+                        counterRec++;
+                        if (result.x < COLSIMAGE / 2)   // 标识牌在左侧
+                            leftEnable = true;
+                        else
+                            leftEnable = false;
+                        found = true;
+                        break;
+                    }
                 }
+                if (found)
+                    break;
             }
 
             if (counterRec)
@@ -186,7 +198,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(Tracking track, Mat &image)
+    void drawImage(const Tracking &track, Mat &image)
     {
         // 赛道边缘
         for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -246,6 +258,7 @@ private:
     bool leftEnable = true;         // 标识牌在左侧
     bool searchingLine = false;     // 搜索直线标志
     vector<Vec4i> mergedLines;      // 合并后的线段用于绘制
+    vector<Vec4i> lines;            // 本帧检测到的线段（按y坐标排序）
     int moment = 110;               // 停车时机，屏幕上方的像素值，值越大越越晚停车
     int stopTime = 40;              // 停车时间 40帧
 };
\ No newline at end of file
@@ -38,6 +38,15 @@ class Obstacle
 {
 
 public:
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_BLOCK) | PredictResults::bit(LABEL_CONE) |
+                                       PredictResults::bit(LABEL_PEDESTRIAN); // 触发类别
+
+    /**
+     * @brief 场景空闲：上一帧未避障（本帧无触发类别时可跳过检测，检测结果同为未使能）
+     *
+     */
+    bool idle(void) const { return !enable; }
+
     /**
      * @brief 障碍区AI识别与路径规划处理
      *
@@ -46,17 +55,20 @@ public:
      * @return true
      * @return false
      */
-    bool process(Tracking &track, vector<PredictResult> predict)
+    bool process(Tracking &track, const PredictResults &predict)
     {
         enable = false; // 场景检测使能标志
         if (track.pointsEdgeLeft.size() < ROWSIMAGE / 2 || track.pointsEdgeRight.size() < ROWSIMAGE / 2)
             return enable;
 
-        vector<PredictResult> resultsObs; // 锥桶AI检测数据
-        for (size_t i = 0; i < predict.size(); i++)
+        FrameVector<PredictResult> resultsObs; // 锥桶AI检测数据（单帧内存池）
+        for (int type : {LABEL_BLOCK, LABEL_CONE, LABEL_PEDESTRIAN}) // 类别升序：与检测结果顺序一致
         {
-            if ((predict[i].type == LABEL_CONE || predict[i].type == LABEL_BLOCK || predict[i].type == LABEL_PEDESTRIAN) && (predict[i].y + predict[i].height) > ROWSIMAGE * 0.4) // AI标志距离计算
-                resultsObs.push_back(predict[i]);
+            for (const PredictResult &result : predict.bucket(type))
+            {
+                if ((result.y + result.height) > ROWSIMAGE * 0.4) // AI标志距离计算
+                    resultsObs.push_back(result);
+            }
         }
 
         if (resultsObs.size() <= 0)
@@ -94,7 +106,7 @@ public:
             }
             else if (resultsObs[index].type == LABEL_PEDESTRIAN) // 行人特殊处理
             {
-                vector<POINT> points(4); // 三阶贝塞尔曲线
+                FrameVector<POINT> points(4); // 三阶贝塞尔曲线
                 points[0] = track.pointsEdgeLeft[row / 2];
                 points[1] = {resultsObs[index].y + resultsObs[index].height, resultsObs[index].x + resultsObs[index].width * 2};
                 points[2] = {(resultsObs[index].y + resultsObs[index].height + resultsObs[index].y) / 2, resultsObs[index].x + resultsObs[index].width * 2};
@@ -104,14 +116,15 @@ public:
                     points[3] = {resultsObs[index].y, resultsObs[index].x + resultsObs[index].width};
 
                 track.pointsEdgeLeft.resize((size_t)row / 2); // 删除错误路线
-                vector<POINT> repair = Bezier(0.01, points);  // 重新规划车道线
+                FrameVector<POINT> repair;
+                Bezier<3>(0.01, points, repair); // 重新规划车道线
                 for (size_t i = 0; i < repair.size(); i++)
                     track.pointsEdgeLeft.push_back(repair[i]);
                 curtailTracking(track, false); // 缩减优化车道线（双车道→单车道）
             }
             else
             {
-                vector<POINT> points(4); // 三阶贝塞尔曲线
+                FrameVector<POINT> points(4); // 三阶贝塞尔曲线
                 points[0] = track.pointsEdgeLeft[row / 2];
                 points[1] = {resultsObs[index].y + resultsObs[index].height, resultsObs[index].x + resultsObs[index].width * 2};
                 points[2] = {(resultsObs[index].y + resultsObs[index].height + resultsObs[index].y) / 2, resultsObs[index].x + resultsObs[index].width * 2};
@@ -121,7 +134,8 @@ public:
                     points[3] = {resultsObs[index].y, resultsObs[index].x + resultsObs[index].width};
 
                 track.pointsEdgeLeft.resize((size_t)row / 2); // 删除错误路线
-                vector<POINT> repair = Bezier(0.01, points);  // 重新规划车道线
+                FrameVector<POINT> repair;
+                Bezier<3>(0.01, points, repair); // 重新规划车道线
                 for (size_t i = 0; i < repair.size(); i++)
                     track.pointsEdgeLeft.push_back(repair[i]);
             }
@@ -136,7 +150,7 @@ public:
             }
             else if (resultsObs[index].type == LABEL_PEDESTRIAN) // 行人特殊处理
             {
-                vector<POINT> points(4); // 三阶贝塞尔曲线
+                FrameVector<POINT> points(4); // 三阶贝塞尔曲线
                 points[0] = track.pointsEdgeRight[row / 2];
                 points[1] = {resultsObs[index].y + resultsObs[index].height, resultsObs[index].x - resultsObs[index].width};
                 points[2] = {(resultsObs[index].y + resultsObs[index].height + resultsObs[index].y) / 2, resultsObs[index].x - resultsObs[index].width};
@@ -146,14 +160,15 @@ public:
                     points[3] = {resultsObs[index].y, resultsObs[index].x};
 
                 track.pointsEdgeRight.resize((size_t)row / 2); // 删除错误路线
-                vector<POINT> repair = Bezier(0.01, points);   // 重新规划车道线
+                FrameVector<POINT> repair;
+                Bezier<3>(0.01, points, repair); // 重新规划车道线
                 for (size_t i = 0; i < repair.size(); i++)
                     track.pointsEdgeRight.push_back(repair[i]);
                 curtailTracking(track, true); // 缩减优化车道线（双车道→单车道）
             }
             else
             {
-                vector<POINT> points(4); // 三阶贝塞尔曲线
+                FrameVector<POINT> points(4); // 三阶贝塞尔曲线
                 points[0] = track.pointsEdgeRight[row / 2];
                 points[1] = {resultsObs[index].y + resultsObs[index].height, resultsObs[index].x - resultsObs[index].width};
                 points[2] = {(resultsObs[index].y + resultsObs[index].height + resultsObs[index].y) / 2, resultsObs[index].x - resultsObs[index].width};
@@ -163,7 +178,8 @@ public:
                     points[3] = {resultsObs[index].y, resultsObs[index].x};
 
                 track.pointsEdgeRight.resize((size_t)row / 2); // 删除错误路线
-                vector<POINT> repair = Bezier(0.01, points);   // 重新规划车道线
+                FrameVector<POINT> repair;
+                Bezier<3>(0.01, points, repair); // 重新规划车道线
                 for (size_t i = 0; i < repair.size(); i++)
                     track.pointsEdgeRight.push_back(repair[i]);
             }
@@ -27,6 +27,7 @@
  #include <opencv2/opencv.hpp>
  #include "../../include/common.hpp"
  #include "../../include/detection.hpp"
+ #include "../../include/features.hpp"
  #include "../recognition/tracking.cpp"
 
 using namespace cv;
@@ -51,7 +52,21 @@ public:
     
     ParkStep step = ParkStep::none; // 停车步骤
 
-    bool process(Tracking &track, Mat &image, vector<PredictResult> predict)
+    static constexpr uint32_t LABELS = PredictResults::bit(LABEL_BATTERY); // 触发类别
+
+    /**
+     * @brief 场景空闲：未进入停车场且无待确认的AI标志（本帧无触发类别时可跳过检测，改为调用skip）
+     *
+     */
+    bool idle(void) const { return step == ParkStep::none && counterRec == 0; }
+
+    /**
+     * @brief 跳过检测：空闲帧仅场次计数（与process空转一致）
+     *
+     */
+    void skip(void) { counterSession++; }
+
+    bool process(Tracking &track, LineFeatures &features, const PredictResults &predict)
     {
         counterSession++;
         if (step!= ParkStep::none && counterSession > 80) // 超时退出
@@ -70,9 +85,9 @@ public:
         {
             case ParkStep::none: // AI未识别
             {
-                for (size_t i = 0; i < predict.size(); i++)
+                for (const PredictResult &result : predict.bucket(LABEL_BATTERY))
                 {
-                    if ((predict[i].type == LABEL_BATTERY) && predict[i].score > 0.4)
+                    if (result.score > 0.4)
                     {
                         counterRec++;
                         break;
@@ -103,27 +118,25 @@ public:
                 int carY = ROWSIMAGE;
                 int batteryY = ROWSIMAGE;     // 充电站标识高度
                 
-                for (size_t i = 0; i < predict.size(); i++)
+                for (const PredictResult &result : predict.bucket(LABEL_CAR))
                 {
-                    if (predict[i].type == LABEL_CAR && predict[i].score > 0.6)
+                    if (result.score > 0.6)
                     {
-                        carY = (predict[i].y + predict[i].height)/2;   // 计算智能车的中心高度
+                        carY = (result.y + result.height)/2;   // 计算智能车的中心高度
                     }
-                    else if ((predict[i].type == LABEL_BATTERY) && predict[i].score > 0.6)
+                }
+                for (const PredictResult &result : predict.bucket(LABEL_BATTERY))
+                {
+                    if (result.score > 0.6)
                     {
-                        batteryY = predict[i].y ;   // 计算标识牌最高高度
+                        batteryY = result.y ;   // 计算标识牌最高高度
                     }
                 }
-                // 图像预处理
-                Mat edges;
-                Canny(image, edges, 50, 150);
-
-                // 霍夫变换检测直线
-                vector<Vec4i> lines;
-                HoughLinesP(edges, lines, 1, CV_PI/180, 40, 20, 10);
+                // 边缘检测+霍夫变换检测直线（方向角范围同下方筛选）：帧内共享缓存
+                const vector<Vec4i> &lines = features.lines({false, 50, 150, 3}, {1, CV_PI/180, 40, 20, 10, -30, 0});
 
-                vector<Vec4i> horizontalLines;
-                Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
+                FrameVector<Vec4i> horizontalLines;
+                // Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
                 for(const Vec4i& line : lines) 
                 {
                     Point pt1(line[0], line[1]);
@@ -137,7 +150,7 @@ public:
                     if(abs(angle) < 30 && angle < 0 && midY < batteryY && midY < 200 &&  midX > COLSIMAGE/2) 
                     { // 接近水平
                         horizontalLines.push_back(line);
-                        cv::line(imgRes, Point(line[0], line[1]), Point(line[2], line[3]), Scalar(0, 0, 255), 2);
+                        // cv::line(imgRes, Point(line[0], line[1]), Point(line[2], line[3]), Scalar(0, 0, 255), 2);
                     }
                 }
                 // imshow("Detected Lines", imgRes);
@@ -202,16 +215,11 @@ public:
             }
             case ParkStep::turning: // 入库转向
             {
-                // 图像预处理
-                Mat edges;
-                Canny(image, edges, 50, 150);
-
-                // 霍夫变换检测直线
-                vector<Vec4i> lines;
-                HoughLinesP(edges, lines, 1, CV_PI/180, 40, 40, 10);
+                // 边缘检测+霍夫变换检测直线（方向角范围同下方筛选）：帧内共享缓存
+                const vector<Vec4i> &lines = features.lines({false, 50, 150, 3}, {1, CV_PI/180, 40, 40, 10, -40, 0});
 
-                vector<Vec4i> horizontalLines;
-                Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
+                FrameVector<Vec4i> horizontalLines;
+                // Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
                 for(const Vec4i& line : lines) {
                     Point pt1(line[0], line[1]);
                     Point pt2(line[2], line[3]);
@@ -224,7 +232,7 @@ public:
                     if(abs(angle) < 40 && angle < 0 &&  midX > COLSIMAGE/2) 
                     { 
                         horizontalLines.push_back(line);
-                        cv::line(imgRes, Point(line[0], line[1]), Point(line[2], line[3]), Scalar(0, 0, 255), 2);
+                        // cv::line(imgRes, Point(line[0], line[1]), Point(line[2], line[3]), Scalar(0, 0, 255), 2);
                         int midY = (line[1] + line[3]) / 2;     // 计算直线中点y坐标
                         if (midY > lineY && (midY - lineY) <= 10) // 限制线段增加值
                         {
@@ -325,7 +333,7 @@ public:
      * @brief 识别结果图像绘制
      *
      */
-    void drawImage(Tracking track, Mat &image)
+    void drawImage(const Tracking &track, Mat &image)
     {
         // 赛道边缘
         for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -350,8 +358,8 @@ private:
     bool garageFirst = true;      // 进入一号车库
     int lineY = 0;                // 直线高度
     bool startTurning = false;    // 开始转弯
-    vector<vector<POINT>> pathsEdgeLeft; // 记录入库路径
-    vector<vector<POINT>> pathsEdgeRight;
+    vector<EdgePoints> pathsEdgeLeft; // 记录入库路径
+    vector<EdgePoints> pathsEdgeRight;
     Point ptA = Point(0, 0);      // 记录线段的两个端点
     Point ptB = Point(0, 0);
     int truningTime = 21;             // 转弯时间 21帧
@@ -20,21 +20,17 @@
  *
  */
 
+#include "../include/capture.hpp"    //V4L2零拷贝图像采集
 #include "../include/common.hpp"     //公共类方法文件
 #include "../include/detection.hpp"  //百度Paddle框架移动端部署
+#include "../include/heapaudit.hpp"  //稳态堆分配审计
+#include "../include/pipeline.hpp"   //多线程流水线
+#include "../include/profiler.hpp"   //分阶段耗时统计
 #include "../include/uart.hpp"       //串口通信驱动
-#include "controlcenter.cpp"         //控制中心计算类
-#include "detection/bridge.cpp"      //AI检测：坡道区
-#include "detection/obstacle.cpp"    //AI检测：障碍区
-#include "detection/catering.cpp"    //AI检测：餐饮区
-#include "detection/layby.cpp"       //AI检测：临时停车区
-#include "detection/parking.cpp"     //AI检测：充电停车场
-#include "detection/crosswalk.cpp"   //AI检测：停车区
+#include "decision.cpp"              //场景决策类
 #include "motion.cpp"                //智能车运动控制类
 #include "preprocess.cpp"            //图像预处理类
-#include "recognition/crossroad.cpp" //十字道路识别与路径规划类
-#include "recognition/ring.cpp"      //环岛道路识别与路径规划类
-#include "recognition/tracking.cpp"  //赛道识别基础类
+#include <climits>
 #include <iostream>
 #include <opencv2/highgui.hpp> //OpenCV终端部署
 #include <opencv2/opencv.hpp>  //OpenCV终端部署
@@ -44,28 +40,71 @@
 using namespace std;
 using namespace cv;
 
+#define PIPELINE_DEPTH 2  // 流水线级间队列深度
+#define CAPTURE_BUFFERS 8 // V4L2驱动缓冲区个数
+
+// 同时持有驱动缓冲区的采集帧：最新帧交换槽2（写缓冲+中间缓冲）+ 采集线程1 + 采集→预处理队列 + 预处理线程1，
+// 另需至少2个缓冲区留在驱动中持续采集
+static_assert(CAPTURE_BUFFERS >= 2 + 1 + PIPELINE_DEPTH + 1 + 2, "V4L2 buffers must cover the frames in flight");
+
+/**
+ * @brief 流水线帧数据
+ *
+ */
+struct FrameData {
+  uint64_t seq = 0;              // 帧序号
+  uint64_t stamp = 0;            // 采集时刻（Profiler时钟）
+  CaptureFrame raw;              // 采集帧（驱动缓冲区视图）
+  Mat img;                       // 原始图像
+  Mat imgCorrect;                // 矫正图像
+  Mat imgBinary;                 // 二值化图像
+  PredictResults results; // AI推理结果
+};
+
+/**
+ * @brief 异步推理结果
+ *
+ */
+struct DetectionResult {
+  uint64_t seq = 0;              // 推理输入帧序号
+  PredictResults results; // AI推理结果
+};
+
 void mouseCallback(int event, int x, int y, int flags, void *userdata);
+bool actuate(shared_ptr<Uart> &uart, const Command &cmd);
+void exitSystem(shared_ptr<Uart> &uart);
+void drawDebug(Decision &decision, Motion &motion, const Command &cmd,
+               shared_ptr<Detection> &detection, FrameData &frame);
 Display display; // 初始化UI显示窗口
 
 int main(int argc, char const *argv[]) {
-  Preprocess preprocess;    // 图像预处理类
-  Motion motion;            // 运动控制类
-  Tracking tracking;        // 赛道识别类
-  Crossroad crossroad;      // 十字道路识别类
-  Ring ring;                // 环岛识别类
-  Bridge bridge;            // 坡道区检测类
-  Catering catering;        // 快餐店检测类
-  Obstacle obstacle;        // 障碍区检测类
-  Layby layby;              // 临时停车区检测类
-  Parking parking;          // 充电停车场检测类
-  StopArea stopArea;        // 停车区识别与路径规划类
-  ControlCenter ctrlCenter; // 控制中心计算类
-  VideoCapture capture;     // Opencv相机类
-  int countInit = 0;        // 初始化计数器
+  Preprocess preprocess;       // 图像预处理类
+  Motion motion;               // 运动控制类
+  Decision decision(motion);   // 场景决策类
+  VideoCapture capture;        // Opencv相机类（调试：本地视频逐帧定位）
+  shared_ptr<CaptureLatest> camera; // 摄像头（V4L2零拷贝采集，只取最新帧）
 
   // 目标检测类(AI模型文件)
-  shared_ptr<Detection> detection = make_shared<Detection>(motion.params.model);
+  shared_ptr<Detection> detection = make_shared<Detection>(motion.params.model, motion.params.backend,
+                                                          motion.params.detectionFile, motion.params.recordDetection,
+                                                          motion.params.nativePost);
   detection->score = motion.params.score; // AI检测置信度
+  detection->keyframeMax = motion.params.keyframeMax;     // AI关键帧最大间隔
+  detection->keyframeDecay = motion.params.keyframeDecay; // 传播帧置信度衰减
+
+  // 分阶段耗时统计：周期输出或kill -USR1触发输出
+  if (motion.params.profile) {
+    profiler.deadline(PROFILE_FRAME, motion.params.profileDeadline);
+    profiler.start(motion.params.profileFile, motion.params.profilePeriod);
+  }
+
+  // 时间线追踪：Chrome Trace Event JSON（chrome://tracing 或 ui.perfetto.dev 打开）
+  if (motion.params.trace && tracer.start(motion.params.traceFile, profiler.tick(), Profiler::ticks()))
+    tracer.thread("main");
+
+  // 稳态堆分配审计：预热帧之后决策线程内的堆分配上报调用栈
+  HeapAudit::mode = (HeapAudit::Mode)motion.params.heapAudit;
+  HeapAudit::warmup = motion.params.heapAuditWarmup;
 
   // USB转串口初始化： /dev/ttyUSB0
   shared_ptr<Uart> uart = make_shared<Uart>("/dev/ttyUSB0"); // 初始化串口驱动
@@ -77,17 +116,22 @@ int main(int argc, char const *argv[]) {
   uart->startReceive(); // 启动数据接收子线程
 
   // USB摄像头初始化
-  if (motion.params.debug)
+  if (motion.params.debug) {
     capture = VideoCapture(motion.params.video); // 打开本地视频
-  else
-    capture = VideoCapture("/dev/video0"); // 打开摄像头
-  if (!capture.isOpened()) {
-    printf("can not open video device!!!\n");
-    return 0;
+    if (!capture.isOpened()) {
+      printf("can not open video device!!!\n");
+      return 0;
+    }
+    capture.set(CAP_PROP_FRAME_WIDTH, COLSIMAGE);  // 设置图像分辨率
+    capture.set(CAP_PROP_FRAME_HEIGHT, ROWSIMAGE); // 设置图像分辨率
+    capture.set(CAP_PROP_FPS, 30);                 // 设置帧率
+  } else {
+    camera = make_shared<CaptureLatest>(Capture::create(motion.params.camera, COLSIMAGE, ROWSIMAGE, 30, CAPTURE_BUFFERS)); // 打开摄像头
+    if (!camera->isOpened()) {
+      printf("can not open video device!!!\n");
+      return 0;
+    }
   }
-  capture.set(CAP_PROP_FRAME_WIDTH, COLSIMAGE);  // 设置图像分辨率
-  capture.set(CAP_PROP_FRAME_HEIGHT, ROWSIMAGE); // 设置图像分辨率
-  capture.set(CAP_PROP_FPS, 30);                 // 设置帧率
 
   if (motion.params.debug)
   {
@@ -113,13 +157,158 @@ int main(int argc, char const *argv[]) {
     uart->buzzerSound(uart->BUZZER_START); // 祖传提示音效
   }
 
+  //--------------------------------------------[流水线模式]--------------------------------------------
+  // [采集] → [预处理] → [AI推理] → [识别/控制] → [执行]：每级独占线程，级间通过无锁环形队列传递帧数据
+  // 各级只取队列中最新一帧：下一级处理慢时积压的过期帧直接丢弃（计入Stale）
+  // 异步推理模式：[预处理] → [识别/控制] 逐帧直通，AI推理线程只取最新帧，推理结果经交换槽发布
+  if (motion.params.pipeline && !motion.params.debug) {
+    atomic<bool> running(true);
+    bool async = motion.params.asyncInference;             // 异步推理使能
+    RingBuffer<FrameData, PIPELINE_DEPTH> queueCapture;   // 采集→预处理
+    RingBuffer<FrameData, PIPELINE_DEPTH> queuePreprocess; // 预处理→AI推理
+    RingBuffer<FrameData, PIPELINE_DEPTH> queueInference;  // AI推理→识别/控制（异步：预处理→识别/控制）
+    RingBuffer<Command, PIPELINE_DEPTH> queueCommand;      // 识别/控制→执行
+    TripleBuffer<FrameData> slotFrame;                     // 异步：预处理→AI推理（最新帧）
+    TripleBuffer<DetectionResult> slotResult;              // 异步：AI推理→识别/控制（最新结果）
+
+    //[01] 视频源读取
+    thread threadCapture([&]() {
+      tracer.thread("capture");
+      uint64_t seq = 0;
+      while (running) {
+        FrameData frame;
+        if (!camera->read(frame.raw)) { // 只取出驱动缓冲区，不做像素处理
+          if (!camera->isOpened()) {    // 采集源结束（本地视频替身读完）：停止流水线
+            running = false;
+            break;
+          }
+          continue;
+        }
+        frame.stamp = Profiler::ticks();
+        frame.seq = seq++;
+        if (frame.seq % 300 == 0) // 采集丢帧统计
+          printf("[Capture] Captured: %lu | Dropped: %lu | Stale: %lu\n", camera->captured(), camera->dropped(),
+                 queueCapture.dropped() + queuePreprocess.dropped() + queueInference.dropped());
+        if (!queueCapture.pushWait(std::move(frame), running))
+          break;
+      }
+    });
+
+    //[02] 图像预处理
+    thread threadPreprocess([&]() {
+      tracer.thread("preprocess");
+      FrameData frame;
+      while (queueCapture.popLatestWait(frame, running)) {
+        Tracer::frame(frame.seq);
+        {
+          ProfileScope profile(PROFILE_CAPTURE);
+          if (!frame.raw.decode(frame.img))
+            continue;
+        }
+        frame.raw.release(); // 缓冲区归还驱动
+        if (motion.params.saveImg) // 存储原始图像
+          savePicture(frame.img);
+        preprocess.acquire(frame.imgCorrect, frame.imgBinary);          // 取空闲输出缓冲
+        preprocess.process(frame.img, frame.imgCorrect, frame.imgBinary); // 图像矫正+二值化
+        frame.img.release();
+        if (async) {
+          FrameData &latest = slotFrame.back(); // 共享图像内存，不拷贝
+          latest.seq = frame.seq;
+          latest.imgCorrect = frame.imgCorrect;
+          slotFrame.publish();
+          if (!queueInference.pushWait(std::move(frame), running))
+            break;
+        } else if (!queuePreprocess.pushWait(std::move(frame), running))
+          break;
+      }
+    });
+
+    //[03] 启动AI推理
+    thread threadInference([&]() {
+      tracer.thread("inference");
+      while (async && running) { // 异步推理：AI推理空闲时取最新帧，旧帧直接丢弃
+        if (!slotFrame.consume()) {
+          this_thread::sleep_for(chrono::microseconds(500));
+          continue;
+        }
+        FrameData &latest = slotFrame.front();
+        Tracer::frame(latest.seq);
+        detection->inference(latest.imgCorrect);
+        DetectionResult &result = slotResult.back();
+        result.seq = latest.seq;
+        result.results = detection->results;
+        slotResult.publish();
+      }
+
+      FrameData frame;
+      while (!async && queuePreprocess.popLatestWait(frame, running)) {
+        Tracer::frame(frame.seq);
+        detection->inference(frame.imgCorrect);
+        frame.results = detection->results;
+        if (!queueInference.pushWait(std::move(frame), running))
+          break;
+      }
+    });
+
+    //[04-16] 赛道识别、场景检测与运动控制
+    thread threadDecision([&]() {
+      tracer.thread("decision");
+      FrameData frame;
+      bool detected = false;        // 异步：已收到推理结果
+      uint64_t seqResult = 0;       // 异步：最新推理结果的输入帧序号
+      PredictResults resultsLatest; // 异步：最新推理结果（仅在发布新结果时更新）
+      while (queueInference.popLatestWait(frame, running)) {
+        Tracer::frame(frame.seq);
+        int age = 0; // AI结果帧龄：当前帧序号-推理帧序号
+        if (async) {
+          if (slotResult.consume()) { // 新结果：与读缓冲交换，不拷贝
+            DetectionResult &result = slotResult.front();
+            seqResult = result.seq;
+            swap(resultsLatest, result.results);
+            detected = true;
+          }
+          age = detected ? (int)((int64_t)frame.seq - (int64_t)seqResult) : INT_MAX;
+          tracer.counter("detection age", Profiler::ticks(), detected ? age : -1); // AI结果帧龄
+        }
+        PredictResults &results = async ? resultsLatest : frame.results;
+        Command cmd;
+        {
+          HeapAudit::Scope audit(frame.seq);
+          decision.trackRecognition(frame.imgBinary);
+          cmd = decision.process(frame.imgBinary, results, age);
+        }
+        FrameArena::local().reset(); // 单帧临时内存回收
+        cmd.seq = frame.seq;
+        cmd.stamp = frame.stamp;
+        if (!queueCommand.pushWait(std::move(cmd), running))
+          break;
+      }
+    });
+
+    //[17] 执行：串口下发控制指令（主线程）
+    Command cmd;
+    while (queueCommand.popWait(cmd, running))
+      if (!actuate(uart, cmd))
+        break;
+
+    running = false; // 停止各级线程，全部退出后再释放资源
+    threadCapture.join();
+    threadPreprocess.join();
+    threadInference.join();
+    threadDecision.join();
+    camera->release();
+    exitSystem(uart);
+    return 0;
+  }
+
+  //--------------------------------------------[顺序模式]--------------------------------------------
   // 初始化参数
-  Scene scene = Scene::NormalScene;     // 初始化场景：常规道路
-  Scene sceneLast = Scene::NormalScene; // 记录上一次场景状态
-  long preTime;
-  Mat img;
+  uint64_t preTime = 0;
+  FrameData frame;
 
   while (1) {
+    Tracer::frame(frame.seq + 1); // 本帧序号（采集成功后递增）
+
     //[01] 视频源读取
     if (motion.params.debug) // 综合显示调试UI窗口
     {
@@ -129,258 +318,198 @@ int main(int argc, char const *argv[]) {
         usleep(300 * 1000); // us延迟
         continue;
       }
-      preTime = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
+      preTime = frame.stamp = Profiler::ticks();
+      ProfileScope profile(PROFILE_CAPTURE);
       capture.set(cv::CAP_PROP_POS_FRAMES, display.index); // 设置读取帧
-      if (!capture.read(img))
+      if (!capture.read(frame.img))
         continue;
       display.indexLast = display.index;
     }
-    else if (!capture.read(img))
-      continue;
-    
+    else {
+      if (!camera->read(frame.raw)) {
+        if (!camera->isOpened()) // 采集源结束（本地视频替身读完）
+          break;
+        continue;
+      }
+      frame.stamp = Profiler::ticks();
+      ProfileScope profile(PROFILE_CAPTURE);
+      if (!frame.raw.decode(frame.img))
+        continue;
+      frame.raw.release(); // 缓冲区归还驱动
+      if (frame.seq % 300 == 0) // 采集丢帧统计
+        printf("[Capture] Captured: %lu | Dropped: %lu\n", camera->captured(), camera->dropped());
+    }
+    frame.seq++;
+
     if (motion.params.saveImg && !motion.params.debug) // 存储原始图像
-      savePicture(img);
+      savePicture(frame.img);
     else if (motion.params.saveImg && motion.params.debug) // 存储调式图像
       display.save = true;
 
     //[02] 图像预处理
-    Mat imgCorrect = preprocess.correction(img);         // 图像矫正
-    Mat imgBinary = preprocess.binaryzation(imgCorrect); // 图像二值化
+    preprocess.process(frame.img, frame.imgCorrect, frame.imgBinary); // 图像矫正+二值化
 
     //[03] 启动AI推理
-    detection->inference(imgCorrect);
+    detection->inference(frame.imgCorrect);
 
     //[04] 赛道识别
-    tracking.rowCutUp = motion.params.rowCutUp; // 图像顶部切行（前瞻距离）
-    tracking.rowCutBottom = motion.params.rowCutBottom; // 图像底部切行（盲区距离）
-    tracking.trackRecognition(imgBinary);
+    decision.trackRecognition(frame.imgBinary);
     if (motion.params.debug) // 综合显示调试UI窗口
     {
-      Mat imgTrack = imgCorrect.clone();
-      tracking.drawImage(imgTrack); // 图像绘制赛道识别结果
+      Mat imgTrack = frame.imgCorrect.clone();
+      decision.tracking.drawImage(imgTrack); // 图像绘制赛道识别结果
       display.setNewWindow(2, "Track", imgTrack);
     }
 
-    //[05] 停车区检测
-    if (motion.params.stop) {
-      if (stopArea.process(detection->results)) 
-      {
-        scene = Scene::StopScene;
-        if (stopArea.countExit > 20) {
-          uart->carControl(0, PWMSERVOMID); // 控制车辆停止运动
-          sleep(1);
-          printf("-----> System Exit!!! <-----\n");
-          exit(0); // 程序退出
-        }
-      }
-    }
-    
-    //[06] 快餐店检测
-    if ((scene == Scene::NormalScene || scene == Scene::CateringScene) &&
-        motion.params.catering) {
-      if (catering.process(tracking,imgBinary,detection->results))  // 传入二值化图像进行再处理
-        scene = Scene::CateringScene;
-      else
-        scene = Scene::NormalScene;
-    }
+    //[05-16] 场景检测与运动控制
+    Command cmd = decision.process(frame.imgBinary, detection->results);
+    FrameArena::local().reset(); // 单帧临时内存回收
+    cmd.seq = frame.seq;
+    cmd.stamp = frame.stamp;
 
-    //[07] 临时停车区检测
-    if ((scene == Scene::NormalScene || scene == Scene::LaybyScene) &&
-        motion.params.catering) {
-      if (layby.process(tracking,imgBinary,detection->results))  // 传入二值化图像进行再处理
-        scene = Scene::LaybyScene;
-      else
-        scene = Scene::NormalScene;
-    }
+    //[15] 综合显示调试UI窗口
+    if (motion.params.debug) {
+      // 帧率计算（单调时钟）
+      double frameTime = profiler.milliseconds(Profiler::ticks() - preTime);
+      printf(">> FrameTime: %.1fms | %.2ffps \n", frameTime, 1000.0 / frameTime);
 
-    //[08] 充电停车场检测
-    if ((scene == Scene::NormalScene || scene == Scene::ParkingScene) &&
-        motion.params.parking) {
-      if (parking.process(tracking,imgBinary,detection->results))  // 传入二值化图像进行再处理
-        scene = Scene::ParkingScene;
-      else
-        scene = Scene::NormalScene;
-    }
-    
-    //[09] 坡道区检测
-    if ((scene == Scene::NormalScene || scene == Scene::BridgeScene) &&
-        motion.params.bridge) {
-      if (bridge.process(tracking, detection->results))
-        scene = Scene::BridgeScene;
-      else
-        scene = Scene::NormalScene;
+      drawDebug(decision, motion, cmd, detection, frame);
     }
 
-    // [10] 障碍区检测
-    if ((scene == Scene::NormalScene || scene == Scene::ObstacleScene) &&
-        motion.params.obstacle) {
-      if (obstacle.process(tracking, detection->results)) {
-        uart->buzzerSound(uart->BUZZER_DING); // 祖传提示音效
-        scene = Scene::ObstacleScene;
-      } else
-        scene = Scene::NormalScene;
-    }
+    //[17] 执行：串口下发控制指令
+    if (!actuate(uart, cmd))
+      break;
+  }
 
-    //[11] 十字道路识别与路径规划
-    if ((scene == Scene::NormalScene || scene == Scene::CrossScene) &&
-        motion.params.cross) {
-      if (crossroad.crossRecognition(tracking))
-        scene = Scene::CrossScene;
-      else
-        scene = Scene::NormalScene;
-    }
+  capture.release();
+  if (camera)
+    camera->release();
+  exitSystem(uart);
+  return 0;
+}
 
-    //[12] 环岛识别与路径规划
-    if ((scene == Scene::NormalScene || scene == Scene::RingScene) &&
-        motion.params.ring && catering.noRing) {
-      if (ring.process(tracking, imgBinary))
-        scene = Scene::RingScene;
-      else
-        scene = Scene::NormalScene;
-    }
+/**
+ * @brief 执行控制指令：串口下发速度/方向与提示音效
+ *
+ * @param uart 串口驱动
+ * @param cmd 控制指令
+ * @return false 停车退出（指令要求或按键）：由主线程停止流水线后退出程序
+ */
+bool actuate(shared_ptr<Uart> &uart, const Command &cmd) {
+  if (cmd.exit) {
+    uart->carControl(0, PWMSERVOMID); // 控制车辆停止运动
+    return false;
+  }
 
-    //[13] 车辆控制中心拟合
-    ctrlCenter.fitting(tracking);
-    
-    if (scene != Scene::ParkingScene)
-    {
-      if (ctrlCenter.derailmentCheck(tracking)) // 车辆冲出赛道检测（保护车辆）
-      {
-        uart->carControl(0, PWMSERVOMID); // 控制车辆停止运动
-        sleep(1);
-        printf("-----> System Exit!!! <-----\n");
-        exit(0); // 程序退出
-      }
+  Tracer::frame(cmd.seq);
+  {
+    ProfileScope profile(PROFILE_UART);
+    if (cmd.soundDetect == SoundDing)
+      uart->buzzerSound(uart->BUZZER_DING); // 祖传提示音效
+
+    if (cmd.control)
+      uart->carControl(cmd.speed, cmd.servoPwm); // 串口通信控制车辆
+
+    if (cmd.soundScene == SoundDing)
+      uart->buzzerSound(uart->BUZZER_DING); // 祖传提示音效
+    else if (cmd.soundScene == SoundOk)
+      uart->buzzerSound(uart->BUZZER_OK); // 祖传提示音效
+  }
+  if (cmd.stamp && (profiler.enable || tracer.enabled())) { // 整帧耗时：采集→串口下发
+    const uint64_t now = Profiler::ticks();
+    if (profiler.enable) {
+      profiler.record(PROFILE_FRAME, now - cmd.stamp);
+      profiler.poll();
     }
+    tracer.frameSpan(cmd.seq, cmd.stamp, now, (int)cmd.scene);
+    tracer.counter("scene", now, (int)cmd.scene); // 场景状态曲线
+  }
 
-    //[14] 运动控制(速度+方向)
-    if (!motion.params.debug && countInit > 30) // 非调试模式下
-    {
-      // 触发停车
-      if ((catering.stopEnable && scene == Scene::CateringScene) || (layby.stopEnable && scene == Scene::LaybyScene) || (parking.step == parking.ParkStep::stop))
-      {
-        motion.speed = 0;
-      }
-      else if (scene == Scene::CateringScene)
-        motion.speed = motion.params.speedCatering;
-      else if (scene == Scene::LaybyScene)
-        motion.speed = motion.params.speedLayby;
-      else if (scene == Scene::ParkingScene && parking.step == parking.ParkStep::trackout) // 倒车出库
-        motion.speed = -motion.params.speedDown;
-      else if (scene == Scene::ParkingScene) // 减速
-        motion.speed = motion.params.speedParking;
-      else if (scene == Scene::BridgeScene) // 坡道速度
-        motion.speed = motion.params.speedBridge;
-      else if (scene == Scene::ObstacleScene) // 危险区速度
-        motion.speed = motion.params.speedObstacle;
-      else if (scene == Scene::RingScene) // 环岛速度
-        motion.speed = motion.params.speedRing;
-      else if (scene == Scene::StopScene)
-        motion.speed = motion.params.speedDown;
-      else
-        motion.speedCtrl(true, false, ctrlCenter); // 车速控制
-
-      motion.poseCtrl(ctrlCenter.controlCenter); // 姿态控制（舵机）
-      uart->carControl(motion.speed, motion.servoPwm); // 串口通信控制车辆
-    } else
-      countInit++;
+  // 按键退出程序
+  if (uart->keypress) {
+    uart->carControl(0, PWMSERVOMID); // 控制车辆停止运动
+    return false;
+  }
+  return true;
+}
 
-    //[15] 综合显示调试UI窗口
-    if (motion.params.debug) {
-      // 帧率计算
-      auto startTime = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
-      printf(">> FrameTime: %ldms | %.2ffps \n", startTime - preTime, 1000.0 / (startTime - preTime));
-
-      detection->drawBox(imgCorrect); // 图像绘制AI结果
-      ctrlCenter.drawImage(tracking, imgCorrect); // 图像绘制路径计算结果（控制中心）
-      putText(imgCorrect, formatDoble2String(motion.speed, 1) + "m/s", Point(COLSIMAGE - 70, 80),
-              FONT_HERSHEY_PLAIN, 1, Scalar(0, 0, 255), 1); // 显示车速
-              
-      display.setNewWindow(1, "Binary", imgBinary);
-      Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
-
-      switch (scene) {
-      case Scene::NormalScene:
-        break;
-      case Scene::CrossScene:                  // [ 十字区 ]
-        crossroad.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "+", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::RingScene:              // [ 环岛 ]
-        ring.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "H", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::CateringScene:          // [ 餐饮区 ]
-        catering.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "C", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::LaybyScene:          // [ 临时停车区 ]
-        layby.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "T", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::ParkingScene:          // [ 充电停车场 ]
-        parking.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "P", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::BridgeScene:              // [ 坡道区 ]
-        bridge.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "S", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      case Scene::ObstacleScene:    //[ 障碍区 ]
-        obstacle.drawImage(imgRes); // 图像绘制特殊赛道识别结果
-        circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
-        putText(imgCorrect, "X", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
-        break;
-      default: // 常规道路场景：无特殊路径规划
-        break;
-      }
+/**
+ * @brief 程序退出：各级线程均已结束，输出统计并关闭串口
+ *
+ * @param uart 串口驱动
+ */
+void exitSystem(shared_ptr<Uart> &uart) {
+  sleep(1);
+  profiler.dump(); // 输出耗时统计
+  tracer.stop();   // 输出剩余追踪事件
+  uart->close();   // 串口通信关闭
+  if (EdgePoints::overflows()) // 边缘点集容量不足
+    printf("[Edges] overflow: %lu points dropped\n", (unsigned long)EdgePoints::overflows());
+  printf("-----> System Exit!!! <-----\n");
+}
 
-      display.setNewWindow(3, getScene(scene), imgRes);   // 图像绘制特殊场景识别结果
-      display.setNewWindow(4, "Ctrl", imgCorrect);
-      display.show(); // 显示综合绘图
-    }
+/**
+ * @brief 综合显示调试UI窗口
+ *
+ */
+void drawDebug(Decision &decision, Motion &motion, const Command &cmd,
+               shared_ptr<Detection> &detection, FrameData &frame) {
+  Mat &imgCorrect = frame.imgCorrect;
+  Tracking &tracking = decision.tracking;
 
-    //[16] 状态复位
-    if (sceneLast != scene) {
-      if (scene == Scene::NormalScene)
-        uart->buzzerSound(uart->BUZZER_DING); // 祖传提示音效
-      else
-        uart->buzzerSound(uart->BUZZER_OK); // 祖传提示音效
-    }
-    sceneLast = scene; // 记录当前状态
-    if (scene == Scene::ObstacleScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::CrossScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::RingScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::CateringScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::LaybyScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::ParkingScene)
-      scene = Scene::NormalScene;
-    else if (scene == Scene::StopScene)
-      scene = Scene::NormalScene;
-
-    //[17] 按键退出程序
-    if (uart->keypress) {
-      uart->carControl(0, PWMSERVOMID); // 控制车辆停止运动
-      sleep(1);
-      printf("-----> System Exit!!! <-----\n");
-      exit(0); // 程序退出
-    }
+  detection->drawBox(imgCorrect); // 图像绘制AI结果
+  decision.ctrlCenter.drawImage(tracking, imgCorrect); // 图像绘制路径计算结果（控制中心）
+  putText(imgCorrect, formatDoble2String(motion.speed, 1) + "m/s", Point(COLSIMAGE - 70, 80),
+          FONT_HERSHEY_PLAIN, 1, Scalar(0, 0, 255), 1); // 显示车速
+
+  display.setNewWindow(1, "Binary", frame.imgBinary);
+  Mat imgRes = Mat::zeros(Size(COLSIMAGE, ROWSIMAGE), CV_8UC3); // 创建全黑图像
+
+  switch (cmd.scene) {
+  case Scene::NormalScene:
+    break;
+  case Scene::CrossScene:                  // [ 十字区 ]
+    decision.crossroad.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "+", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::RingScene:              // [ 环岛 ]
+    decision.ring.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "H", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::CateringScene:          // [ 餐饮区 ]
+    decision.catering.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "C", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::LaybyScene:          // [ 临时停车区 ]
+    decision.layby.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "T", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::ParkingScene:          // [ 充电停车场 ]
+    decision.parking.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "P", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::BridgeScene:              // [ 坡道区 ]
+    decision.bridge.drawImage(tracking, imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "S", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  case Scene::ObstacleScene:    //[ 障碍区 ]
+    decision.obstacle.drawImage(imgRes); // 图像绘制特殊赛道识别结果
+    circle(imgCorrect, Point(COLSIMAGE / 2, ROWSIMAGE / 2), 40,Scalar(40, 120, 250), -1);
+    putText(imgCorrect, "X", Point(COLSIMAGE / 2 - 25, ROWSIMAGE / 2 + 27),FONT_HERSHEY_PLAIN, 5, Scalar(255, 255, 255), 3);
+    break;
+  default: // 常规道路场景：无特殊路径规划
+    break;
   }
 
-  uart->close(); // 串口通信关闭
-  capture.release();
-  return 0;
+  display.setNewWindow(3, getScene(cmd.scene), imgRes);   // 图像绘制特殊场景识别结果
+  display.setNewWindow(4, "Ctrl", imgCorrect);
+  display.show(); // 显示综合绘图
 }
 
 /**
@@ -23,6 +23,9 @@
  * [1] 设置逆透视图像的掩膜区域（mask）：包括目标变换区域和变换后的成像区域
  * [2] 求解变换矩阵和逆变矩阵
  * [3] 对图像或坐标进行变换
+ * @note 传入相机标定参数时，额外生成“原始图像→俯视图”的复合查找表：
+ *       俯视图像素 →(H逆)→ 矫正域坐标 →(畸变模型k1,k2,p1,p2,k3)→ 原始域坐标，
+ *       镜头矫正与逆透视合并为一次remap，省去中间矫正图像的插值与读写
  */
 
 #include <iostream>
@@ -47,32 +50,61 @@ public:
      */
     Mapping(const cv::Size &origSize, const cv::Size &dstSize)
     {
-        // 原始域：分辨率320x240
-        // The 4-points at the input image
-        m_origPoints.clear();
-        // [第二版无带畸变镜头参数]
-        m_origPoints.push_back(Point2f(0, 214));   // 左下
-        m_origPoints.push_back(Point2f(319, 214)); // 右下
-        m_origPoints.push_back(Point2f(192, 0));   // 右上
-        m_origPoints.push_back(Point2f(128, 0));   // 左上
+        init(origSize, dstSize);
+    };
 
-        // 矫正域：分辨率320x240
-        // The 4-points correspondences in the destination image
-        m_dstPoints.clear();
-        m_dstPoints.push_back(Point2f(100, 400)); // 左下
-        m_dstPoints.push_back(Point2f(220, 400)); // 右下
-        m_dstPoints.push_back(Point2f(220, 0));   // 右上
-        m_dstPoints.push_back(Point2f(100, 0));   // 左上
+    /**
+     * @brief IPM初始化（含镜头畸变矫正）
+     *
+     * @param origSize 输入原始图像Size
+     * @param dstSize 输出图像Size
+     * @param cameraMatrix 摄像机内参矩阵
+     * @param distCoeffs 相机的畸变矩阵
+     */
+    Mapping(const cv::Size &origSize, const cv::Size &dstSize, const Mat &cameraMatrix, const Mat &distCoeffs)
+    {
+        init(origSize, dstSize);
+        createRawMaps(cameraMatrix, distCoeffs);
+    };
 
-        m_origSize = origSize;
-        m_dstSize = dstSize;
-        assert(m_origPoints.size() == 4 && m_dstPoints.size() == 4 && "Orig. points and Dst. points must vectors of 4 points");
-        m_H = getPerspectiveTransform(m_origPoints, m_dstPoints); // 计算变换矩阵 [3x3]
-        m_H_inv = m_H.inv();                                      // 求解逆转换矩阵
+    /**
+     * @brief IPM初始化（从标定文件读取镜头参数）
+     *
+     * @param origSize 输入原始图像Size
+     * @param dstSize 输出图像Size
+     * @param calibration 标定文件路径：../res/calibration/valid/calibration.xml
+     */
+    Mapping(const cv::Size &origSize, const cv::Size &dstSize, const string &calibration)
+    {
+        init(origSize, dstSize);
 
-        createMaps();
+        Mat cameraMatrix, distCoeffs;
+        FileStorage file;
+        if (file.open(calibration, FileStorage::READ)) // 读取本地保存的标定文件
+        {
+            file["cameraMatrix"] >> cameraMatrix;
+            file["distCoeffs"] >> distCoeffs;
+            createRawMaps(cameraMatrix, distCoeffs);
+        }
+        else
+            cout << "打开相机矫正参数失败!!!" << endl;
     };
 
+    /**
+     * @brief 原始图像直接生成俯视图：镜头矫正+逆透视单次remap
+     *
+     * @param _rawImg 原始域图像（未矫正）
+     * @param _dstImg 俯视图像
+     * @return false 未加载镜头参数
+     */
+    bool homographyRaw(const Mat &_rawImg, Mat &_dstImg)
+    {
+        if (m_rawMap1.empty())
+            return false;
+        remap(_rawImg, _dstImg, m_rawMap1, m_rawMap2, INTER_LINEAR);
+        return true;
+    }
+
     /**
      * @brief 单应性反透视变换
      *
@@ -234,6 +266,86 @@ private:
     // Maps
     cv::Mat m_mapX, m_mapY;
     cv::Mat m_invMapX, m_invMapY;
+    cv::Mat m_rawMap1, m_rawMap2; // 原始域→俯视图复合查找表（定点：CV_16SC2+CV_16UC1）
+
+    /**
+     * @brief 生成原始域→俯视图复合查找表
+     *
+     * @note 与initUndistortRectifyMap(R=I, newCameraMatrix=cameraMatrix)的畸变模型一致，
+     *       仅对俯视图中的每个像素求一次原始域坐标
+     */
+    void createRawMaps(const Mat &cameraMatrix, const Mat &distCoeffs)
+    {
+        Mat K, D = Mat::zeros(1, 5, CV_64F);
+        cameraMatrix.convertTo(K, CV_64F);
+        Mat coeffs;
+        distCoeffs.convertTo(coeffs, CV_64F);
+        coeffs = coeffs.reshape(1, 1);
+        coeffs.colRange(0, min(coeffs.cols, 5)).copyTo(D.colRange(0, min(coeffs.cols, 5)));
+
+        const double fx = K.at<double>(0, 0), fy = K.at<double>(1, 1);
+        const double cx = K.at<double>(0, 2), cy = K.at<double>(1, 2);
+        const double k1 = D.at<double>(0), k2 = D.at<double>(1), p1 = D.at<double>(2), p2 = D.at<double>(3), k3 = D.at<double>(4);
+
+        Mat mapX(m_dstSize, CV_32F), mapY(m_dstSize, CV_32F);
+        for (int j = 0; j < m_dstSize.height; ++j)
+        {
+            float *ptRowX = mapX.ptr<float>(j);
+            float *ptRowY = mapY.ptr<float>(j);
+            for (int i = 0; i < m_dstSize.width; ++i)
+            {
+                // 俯视图→矫正域
+                Point2d pt = homography(Point2d(i, j), m_H_inv);
+                if (pt.x < 0 || pt.y < 0 || pt.x > m_origSize.width - 1 || pt.y > m_origSize.height - 1) // 矫正域之外：与两步法一致填充黑色
+                {
+                    ptRowX[i] = ptRowY[i] = -1;
+                    continue;
+                }
+
+                // 矫正域→原始域：归一化坐标叠加径向/切向畸变
+                const double x = (pt.x - cx) / fx, y = (pt.y - cy) / fy;
+                const double r2 = x * x + y * y;
+                const double radial = 1 + r2 * (k1 + r2 * (k2 + r2 * k3));
+                const double xd = x * radial + 2 * p1 * x * y + p2 * (r2 + 2 * x * x);
+                const double yd = y * radial + p1 * (r2 + 2 * y * y) + 2 * p2 * x * y;
+                ptRowX[i] = (float)(fx * xd + cx);
+                ptRowY[i] = (float)(fy * yd + cy);
+            }
+        }
+        convertMaps(mapX, mapY, m_rawMap1, m_rawMap2, CV_16SC2); // 浮点表→定点表
+    }
+
+    /**
+     * @brief 设置掩膜区域并求解变换矩阵
+     *
+     */
+    void init(const cv::Size &origSize, const cv::Size &dstSize)
+    {
+        // 原始域：分辨率320x240
+        // The 4-points at the input image
+        m_origPoints.clear();
+        // [第二版无带畸变镜头参数]
+        m_origPoints.push_back(Point2f(0, 214));   // 左下
+        m_origPoints.push_back(Point2f(319, 214)); // 右下
+        m_origPoints.push_back(Point2f(192, 0));   // 右上
+        m_origPoints.push_back(Point2f(128, 0));   // 左上
+
+        // 矫正域：分辨率320x240
+        // The 4-points correspondences in the destination image
+        m_dstPoints.clear();
+        m_dstPoints.push_back(Point2f(100, 400)); // 左下
+        m_dstPoints.push_back(Point2f(220, 400)); // 右下
+        m_dstPoints.push_back(Point2f(220, 0));   // 右上
+        m_dstPoints.push_back(Point2f(100, 0));   // 左上
+
+        m_origSize = origSize;
+        m_dstSize = dstSize;
+        assert(m_origPoints.size() == 4 && m_dstPoints.size() == 4 && "Orig. points and Dst. points must vectors of 4 points");
+        m_H = getPerspectiveTransform(m_origPoints, m_dstPoints); // 计算变换矩阵 [3x3]
+        m_H_inv = m_H.inv();                                      // 求解逆转换矩阵
+
+        createMaps();
+    }
 
     void createMaps()
     {
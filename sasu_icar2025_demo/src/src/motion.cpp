@@ -1,3 +1,4 @@
+#pragma once
 /**
  ********************************************************************************************************
  *                                               示例代码
@@ -93,6 +94,9 @@ public:
     bool saveImg = false;       // 存图使能
     uint16_t rowCutUp = 10;     // 图像顶部切行
     uint16_t rowCutBottom = 10; // 图像顶部切行
+    bool trackIncremental = false; // 赛道增量搜索使能（以上一帧边缘为种子）
+    int trackWindow = 12;       // 赛道增量搜索窗口半宽（像素）
+    bool houghBand = false;     // 窄带霍夫检测使能（临时停车区/充电停车场）
     bool bridge = true;         // 坡道区使能
     bool catering = true;       // 快餐店使能
     bool layby = true;          // 临时停车区使能
@@ -101,17 +105,38 @@ public:
     bool ring = true;           // 环岛使能
     bool cross = true;          // 十字道路使能
     bool stop = true;           // 停车区使能
-    
+    bool pipeline = false;      // 多线程流水线使能（非调试模式）
+    bool asyncInference = false; // 异步AI推理使能（流水线模式）
+    int detectionAge = 5;       // AI结果最大帧龄（异步推理）
+
     float score = 0.5;          // AI检测置信度
+    bool nativePost = false;    // AI后处理使用内置YOLOv3解码+NMS
+    string backend = "ppnc";    // AI推理后端：ppnc | onnx | replay
+    string detectionFile = "../res/samples/detection.bin"; // 检测记录文件（回放/记录）
+    bool recordDetection = false; // 记录每帧检测结果
+    int keyframeMax = 1;          // AI关键帧最大间隔（1：逐帧推理）
+    float keyframeDecay = 0.9;    // 传播帧置信度衰减系数
     string model = "../res/model/yolov3_mobilenet_v1"; // 模型路径
     string video = "../res/samples/demo.mp4";          // 视频路径
+    string camera = "/dev/video0";                     // 摄像头设备（或本地视频替身）
+    bool profile = false;         // 分阶段耗时统计使能
+    string profileFile = "";      // 耗时统计输出文件（空：标准输出）
+    float profilePeriod = 10;     // 耗时统计周期输出间隔（s，0：仅SIGUSR1/退出时输出）
+    float profileDeadline = 33.3; // 整帧时限（ms）：超过计为超时
+    bool trace = false;           // 时间线追踪使能
+    string traceFile = "../res/samples/trace.json"; // 时间线追踪输出文件（Chrome Trace Event JSON）
+    int heapAudit = 0;            // 稳态堆分配审计：0关闭 | 1记录调用栈 | 2记录并终止
+    int heapAuditWarmup = 100;    // 堆分配审计预热帧数
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(Params, speedLow, speedHigh, speedBridge,
                                    speedCatering, speedLayby, speedObstacle,
                                    speedParking,speedRing, speedDown, runP1, runP2, runP3,
                                    turnP, turnD, debug, saveImg, rowCutUp,
-                                   rowCutBottom, bridge, catering, layby, obstacle,
-                                   parking, ring, cross,stop, score, model,
-                                   video); // 添加构造函数
+                                   rowCutBottom, trackIncremental, trackWindow, houghBand, bridge, catering, layby, obstacle,
+                                   parking, ring, cross,stop, pipeline,
+                                   asyncInference, detectionAge, score, nativePost, backend,
+                                   detectionFile, recordDetection, keyframeMax, keyframeDecay, model,
+                                   video, camera, profile, profileFile, profilePeriod,
+                                   profileDeadline, trace, traceFile, heapAudit, heapAuditWarmup); // 添加构造函数
   };
 
   Params params;                   // 读取控制参数
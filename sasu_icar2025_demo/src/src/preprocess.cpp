@@ -19,14 +19,20 @@
  *
  * @copyright Copyright (c) 2023
  *
+ * @note 单次遍历融合处理（process）：
+ *                  [01] 定点数查表重映射（CV_16SC2+插值系数表，构造时生成一次）
+ *                  [02] 矫正像素就地转灰度（9798/19235/3735 >> 15，同cvtColor）并累计灰度直方图
+ *                  [03] 由直方图计算OTSU阈值，阈值化写入预分配的二值图
  */
 
 #include <fstream>
 #include <iostream>
 #include <cmath>
+#include <cfloat>
 #include <opencv2/highgui.hpp>
 #include <opencv2/opencv.hpp>
 #include "../include/common.hpp"
+#include "../include/profiler.hpp"
 
 using namespace cv;
 using namespace std;
@@ -60,8 +66,102 @@ public:
 			cout << "打开相机矫正参数失败!!!" << endl;
 			enable = false;
 		}
+
+		// 双线性插值定点系数表：与OpenCV remap一致（INTER_TAB_SIZE=32，系数和为1<<15）
+		for (int fy = 0; fy < INTER_TAB_SIZE; fy++)
+		{
+			for (int fx = 0; fx < INTER_TAB_SIZE; fx++)
+			{
+				int *w = weights[fy * INTER_TAB_SIZE + fx];
+				w[0] = (INTER_TAB_SIZE - fx) * (INTER_TAB_SIZE - fy) * INTER_TAB_SIZE;
+				w[1] = fx * (INTER_TAB_SIZE - fy) * INTER_TAB_SIZE;
+				w[2] = (INTER_TAB_SIZE - fx) * fy * INTER_TAB_SIZE;
+				w[3] = fx * fy * INTER_TAB_SIZE;
+			}
+		}
+
+		if (enable)
+			buildMaps(Size(COLSIMAGE, ROWSIMAGE));
 	};
 
+	/**
+	 * @brief 融合预处理：矫正+灰度+OTSU二值化（单次遍历，无逐帧内存分配）
+	 *
+	 * @param frame 输入原始帧（BGR）
+	 * @param imgCorrect 输出矫正图像（尺寸不变时复用内存）
+	 * @param imgBinary 输出二值化图像（尺寸不变时复用内存）
+	 */
+	void process(const Mat &frame, Mat &imgCorrect, Mat &imgBinary)
+	{
+		CV_Assert(frame.type() == CV_8UC3);
+		if (enable && frame.size() != mapSize) // 分辨率变化时重建映射表
+			buildMaps(frame.size());
+
+		imageGray.create(frame.size(), CV_8UC1);
+		imgBinary.create(frame.size(), CV_8UC1);
+		int hist[256] = {0};
+
+		//[01-02] 重映射+灰度+直方图
+		{
+			ProfileScope profile(PROFILE_CORRECTION);
+			if (enable)
+			{
+				imgCorrect.create(frame.size(), CV_8UC3);
+				remapGray(frame, imgCorrect, hist);
+			}
+			else
+			{
+				imgCorrect = frame;
+				for (int row = 0; row < frame.rows; row++)
+				{
+					const uchar *src = frame.ptr<uchar>(row);
+					uchar *gray = imageGray.ptr<uchar>(row);
+					for (int col = 0; col < frame.cols; col++, src += 3)
+					{
+						gray[col] = toGray(src[0], src[1], src[2]);
+						hist[gray[col]]++;
+					}
+				}
+			}
+		}
+
+		//[03] OTSU阈值化
+		ProfileScope profile(PROFILE_BINARY);
+		int thresh = otsu(hist, frame.rows * frame.cols);
+		for (int row = 0; row < frame.rows; row++)
+		{
+			const uchar *gray = imageGray.ptr<uchar>(row);
+			uchar *binary = imgBinary.ptr<uchar>(row);
+			for (int col = 0; col < frame.cols; col++)
+				binary[col] = gray[col] > thresh ? 255 : 0;
+		}
+	}
+
+	/**
+	 * @brief 从输出缓冲池中取一组空闲缓冲（流水线模式：下游释放后循环复用，避免逐帧分配）
+	 *
+	 * @param imgCorrect 矫正图像缓冲
+	 * @param imgBinary 二值化图像缓冲
+	 */
+	void acquire(Mat &imgCorrect, Mat &imgBinary)
+	{
+		for (int i = 0; i < POOL_SIZE; i++)
+		{
+			int index = (indexPool + i) % POOL_SIZE;
+			if (idle(poolCorrect[index]) && idle(poolBinary[index]))
+			{
+				poolCorrect[index].create(ROWSIMAGE, COLSIMAGE, CV_8UC3);
+				poolBinary[index].create(ROWSIMAGE, COLSIMAGE, CV_8UC1);
+				imgCorrect = poolCorrect[index];
+				imgBinary = poolBinary[index];
+				indexPool = (index + 1) % POOL_SIZE;
+				return;
+			}
+		}
+		imgCorrect.release(); // 缓冲池全部在用：本帧重新分配
+		imgBinary.release();
+	}
+
 	/**
 	 * @brief 图像二值化
 	 *
@@ -88,18 +188,12 @@ public:
 	{
 		if (enable)
 		{
-			Size sizeImage; // 图像的尺寸
-			sizeImage.width = image.cols;
-			sizeImage.height = image.rows;
+			if (image.size() != mapSize) // 分辨率变化时重建映射表
+				buildMaps(image.size());
 
-			Mat mapx = Mat(sizeImage, CV_32FC1);	// 经过矫正后的X坐标重映射参数
-			Mat mapy = Mat(sizeImage, CV_32FC1);	// 经过矫正后的Y坐标重映射参数
-			Mat rotMatrix = Mat::eye(3, 3, CV_32F); // 内参矩阵与畸变矩阵之间的旋转矩阵
-
-			// 采用initUndistortRectifyMap+remap进行图像矫正
-			initUndistortRectifyMap(cameraMatrix, distCoeffs, rotMatrix, cameraMatrix, sizeImage, CV_32FC1, mapx, mapy);
-			Mat imageCorrect = image.clone();
-			remap(image, imageCorrect, mapx, mapy, INTER_LINEAR);
+			// 采用initUndistortRectifyMap（构造时生成定点表）+remap进行图像矫正
+			Mat imageCorrect;
+			remap(image, imageCorrect, mapXY, mapFrac, INTER_LINEAR);
 
 			// 采用undistort进行图像矫正
 			//  undistort(image, imageCorrect, cameraMatrix, distCoeffs);
@@ -113,7 +207,131 @@ public:
 	}
 
 private:
+	static const int POOL_SIZE = 12; // 输出缓冲池容量（需大于流水线在途帧数）
+
 	bool enable = false; // 图像矫正使能：初始化完成
 	Mat cameraMatrix;	 // 摄像机内参矩阵
 	Mat distCoeffs;		 // 相机的畸变矩阵
+	Size mapSize;		 // 映射表对应的图像尺寸
+	Mat mapXY;			 // 定点重映射表：整数坐标（CV_16SC2）
+	Mat mapFrac;		 // 定点重映射表：小数坐标插值系数索引（CV_16UC1）
+	Mat imageGray;		 // 灰度图缓冲
+	int weights[INTER_TAB_SIZE * INTER_TAB_SIZE][4]; // 双线性插值定点系数表
+
+	Mat poolCorrect[POOL_SIZE]; // 矫正图像缓冲池
+	Mat poolBinary[POOL_SIZE];	// 二值化图像缓冲池
+	int indexPool = 0;			// 缓冲池轮询起点
+
+	/**
+	 * @brief 生成定点重映射表（仅在初始化或分辨率变化时调用）
+	 *
+	 */
+	void buildMaps(Size sizeImage)
+	{
+		Mat mapx, mapy;
+		Mat rotMatrix = Mat::eye(3, 3, CV_32F); // 内参矩阵与畸变矩阵之间的旋转矩阵
+		initUndistortRectifyMap(cameraMatrix, distCoeffs, rotMatrix, cameraMatrix, sizeImage, CV_32FC1, mapx, mapy);
+		convertMaps(mapx, mapy, mapXY, mapFrac, CV_16SC2); // 浮点表→定点表
+		mapSize = sizeImage;
+	}
+
+	/**
+	 * @brief 灰度转换（与cvtColor COLOR_BGR2GRAY定点算法一致）
+	 *
+	 */
+	static inline uchar toGray(int b, int g, int r)
+	{
+		return (uchar)((b * 3735 + g * 19235 + r * 9798 + (1 << 14)) >> 15);
+	}
+
+	/**
+	 * @brief 定点双线性重映射，同时输出灰度图并统计直方图（边界外像素按0处理）
+	 *
+	 */
+	void remapGray(const Mat &src, Mat &dst, int *hist)
+	{
+		const int cols = src.cols, rows = src.rows;
+		const size_t step = src.step;
+		for (int row = 0; row < dst.rows; row++)
+		{
+			const short *xy = mapXY.ptr<short>(row);
+			const ushort *frac = mapFrac.ptr<ushort>(row);
+			uchar *out = dst.ptr<uchar>(row);
+			uchar *gray = imageGray.ptr<uchar>(row);
+			for (int col = 0; col < dst.cols; col++, out += 3)
+			{
+				const int x = xy[col * 2], y = xy[col * 2 + 1];
+				const int *w = weights[frac[col] & (INTER_TAB_SIZE * INTER_TAB_SIZE - 1)];
+				int bgr[3];
+				if ((unsigned)x < (unsigned)(cols - 1) && (unsigned)y < (unsigned)(rows - 1)) // 四邻域均在图像内
+				{
+					const uchar *p0 = src.data + y * step + x * 3;
+					const uchar *p1 = p0 + step;
+					for (int c = 0; c < 3; c++)
+						bgr[c] = (p0[c] * w[0] + p0[c + 3] * w[1] + p1[c] * w[2] + p1[c + 3] * w[3] + (1 << 14)) >> 15;
+				}
+				else
+				{
+					for (int c = 0; c < 3; c++)
+					{
+						int sum = 0;
+						for (int k = 0; k < 4; k++)
+						{
+							const int px = x + (k & 1), py = y + (k >> 1);
+							if ((unsigned)px < (unsigned)cols && (unsigned)py < (unsigned)rows)
+								sum += src.data[py * step + px * 3 + c] * w[k];
+						}
+						bgr[c] = (sum + (1 << 14)) >> 15;
+					}
+				}
+				out[0] = bgr[0];
+				out[1] = bgr[1];
+				out[2] = bgr[2];
+				gray[col] = toGray(bgr[0], bgr[1], bgr[2]);
+				hist[gray[col]]++;
+			}
+		}
+	}
+
+	/**
+	 * @brief 由灰度直方图计算OTSU阈值（类间方差最大）
+	 *
+	 */
+	static int otsu(const int *hist, int total)
+	{
+		double mu = 0, scale = 1. / total;
+		for (int i = 0; i < 256; i++)
+			mu += i * (double)hist[i];
+		mu *= scale;
+
+		double mu1 = 0, q1 = 0, sigmaMax = 0;
+		int thresh = 0;
+		for (int i = 0; i < 256; i++)
+		{
+			double p = hist[i] * scale;
+			mu1 *= q1;
+			q1 += p;
+			double q2 = 1. - q1;
+			if (std::min(q1, q2) < FLT_EPSILON || std::max(q1, q2) > 1. - FLT_EPSILON)
+				continue;
+			mu1 = (mu1 + i * p) / q1;
+			double mu2 = (mu - q1 * mu1) / q2;
+			double sigma = q1 * q2 * (mu1 - mu2) * (mu1 - mu2);
+			if (sigma > sigmaMax)
+			{
+				sigmaMax = sigma;
+				thresh = i;
+			}
+		}
+		return thresh;
+	}
+
+	/**
+	 * @brief 缓冲是否空闲：未分配，或仅被缓冲池引用
+	 *
+	 */
+	static bool idle(const Mat &mat)
+	{
+		return !mat.u || CV_XADD(&mat.u->refcount, 0) == 1;
+	}
 };
@@ -145,8 +145,9 @@ public:
                         POINT startPoint = pointBreakRD;                                                              // 补线起点
                         POINT endPoint = track.spurroad[indexSP];                                                     // 补线终点
                         POINT midPoint = POINT((startPoint.x + endPoint.x) * 0.5, (startPoint.y + endPoint.y) * 0.5); // 补线中点
-                        vector<POINT> input = {startPoint, midPoint, endPoint};
-                        vector<POINT> repair = Bezier(0.04, input);
+                        FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+                        FrameVector<POINT> repair;
+                        Bezier<2>(0.04, input, repair);
 
                         track.pointsEdgeRight.resize(rowBreakRightDown); // 重绘右边缘
                         for (size_t i = 0; i < repair.size(); i++)
@@ -191,8 +192,9 @@ public:
 
                     POINT startPoint = pointBreakRD;                                                              // 补线起点
                     POINT midPoint = POINT((startPoint.x + endPoint.x) * 0.5, (startPoint.y + endPoint.y) * 0.5); // 补线中点
-                    vector<POINT> input = {startPoint, midPoint, endPoint};
-                    vector<POINT> repair = Bezier(0.05, input);
+                    FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+                    FrameVector<POINT> repair;
+                    Bezier<2>(0.05, input, repair);
 
                     track.pointsEdgeRight.resize(rowBreakRightDown); // 重绘右边缘
                     for (size_t i = 0; i < repair.size(); i++)
@@ -279,8 +281,9 @@ public:
                     POINT startPoint = track.pointsEdgeRight[0];                                                  // 补线起点
                     POINT endPoint = track.spurroad[indexSP];                                                     // 补线终点
                     POINT midPoint = POINT((startPoint.x + endPoint.x) * 0.5, (startPoint.y + endPoint.y) * 0.5); // 补线中点
-                    vector<POINT> input = {startPoint, midPoint, endPoint};
-                    vector<POINT> repair = Bezier(0.04, input);
+                    FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+                    FrameVector<POINT> repair;
+                    Bezier<2>(0.04, input, repair);
 
                     track.pointsEdgeRight.clear(); // 重绘右边缘
                     track.pointsEdgeRight = repair;
@@ -299,7 +302,7 @@ public:
      *
      * @param Image 需要叠加显示的图像/RGB
      */
-    void drawImage(Tracking track, Mat &Image)
+    void drawImage(const Tracking &track, Mat &Image)
     {
         // 绘制边缘点
         for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++)
@@ -384,7 +387,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeftUp(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeftUp(const EdgePoints &pointsEdgeLeft)
     {
         uint16_t rowBreakLeftUp = pointsEdgeLeft.size() - 5;
         uint16_t counter = 0;
@@ -413,7 +416,7 @@ private:
      * @param pointsEdgeLeft
      * @return uint16_t
      */
-    uint16_t searchBreakLeftDown(vector<POINT> pointsEdgeLeft)
+    uint16_t searchBreakLeftDown(const EdgePoints &pointsEdgeLeft)
     {
         uint16_t rowBreakLeft = 0;
         uint16_t counter = 0;
@@ -441,7 +444,7 @@ private:
      * @param pointsEdgeRight
      * @return uint16_t
      */
-    uint16_t searchBreakRightUp(vector<POINT> pointsEdgeRight)
+    uint16_t searchBreakRightUp(const EdgePoints &pointsEdgeRight)
     {
         uint16_t rowBreakRightUp = pointsEdgeRight.size() - 5;
         uint16_t counter = 0;
@@ -470,7 +473,7 @@ private:
      * @param pointsEdgeRight
      * @return uint16_t
      */
-    uint16_t searchBreakRightDown(vector<POINT> pointsEdgeRight)
+    uint16_t searchBreakRightDown(const EdgePoints &pointsEdgeRight)
     {
         uint16_t rowBreakRightDown = 0;
         uint16_t counter = 0;
@@ -512,7 +515,7 @@ private:
      * @return true
      * @return false
      */
-    bool searchStraightCrossroad(vector<POINT> pointsEdgeLeft, vector<POINT> pointsEdgeRight)
+    bool searchStraightCrossroad(const EdgePoints &pointsEdgeLeft, const EdgePoints &pointsEdgeRight)
     {
         if (pointsEdgeLeft.size() < ROWSIMAGE * 0.8 || pointsEdgeRight.size() < ROWSIMAGE * 0.8)
         {
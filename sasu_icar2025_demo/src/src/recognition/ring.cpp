@@ -211,8 +211,9 @@ public:
             POINT midPoint(x, y);                             // 补线：中点
             POINT endPoint(rowYendStraightside, 0);           // 补线：终点
 
-            vector<POINT> input = {startPoint, midPoint, endPoint};
-            vector<POINT> b_modify = Bezier(0.01, input);
+            FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+            FrameVector<POINT> b_modify;
+            Bezier<2>(0.01, input, b_modify);
             track.pointsEdgeLeft.resize(rowRepairRingside);
             track.pointsEdgeRight.resize(rowRepairStraightside);
             for (size_t kk = 0; kk < b_modify.size(); ++kk) {
@@ -270,8 +271,9 @@ public:
               //     break;
               // }
 
-              vector<POINT> input = {startPoint, midPoint, endPoint};
-              vector<POINT> b_modify = Bezier(0.02, input);
+              FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+              FrameVector<POINT> b_modify;
+              Bezier<2>(0.02, input, b_modify);
               track.pointsEdgeLeft.resize(rowRepairRingside);
               track.pointsEdgeRight.resize(rowRepairStraightside);
 
@@ -311,8 +313,9 @@ public:
           POINT midPoint =
               POINT((startPoint.x + endPoint.x) * 0.5,
                     (startPoint.y + endPoint.y) * 0.5); // 补线：中点
-          vector<POINT> input = {startPoint, midPoint, endPoint};
-          vector<POINT> b_modify = Bezier(0.02, input);
+          FrameVector<POINT> input = {startPoint, midPoint, endPoint};
+          FrameVector<POINT> b_modify;
+          Bezier<2>(0.02, input, b_modify);
           track.pointsEdgeRight.resize(0);
           track.pointsEdgeLeft.resize(0);
           for (size_t kk = 0; kk < b_modify.size(); ++kk) {
@@ -376,9 +379,10 @@ public:
                 (track.pointsEdgeRight[rowBreakRight].x + rowBreakpointLeft) *
                     3 / 8,
                 track.pointsEdgeRight[rowBreakRight].y / 2);
-            vector<POINT> input = {track.pointsEdgeRight[rowBreakRight], p_mid,
-                                   p_end};
-            vector<POINT> b_modify = Bezier(0.01, input);
+            FrameVector<POINT> input = {track.pointsEdgeRight[rowBreakRight],
+                                        p_mid, p_end};
+            FrameVector<POINT> b_modify;
+            Bezier<2>(0.01, input, b_modify);
             track.pointsEdgeRight.resize(rowBreakRight);
             for (size_t kk = 0; kk < b_modify.size(); ++kk) {
               track.pointsEdgeRight.emplace_back(b_modify[kk]);
@@ -389,8 +393,9 @@ public:
           POINT p_end(rowBreakpointLeft, 0);
           POINT p_start(max(rowBreakpointRight, ROWSIMAGE - 80), COLSIMAGE);
           POINT p_mid((ROWSIMAGE - 50 + rowBreakpointLeft) / 4, COLSIMAGE / 2);
-          vector<POINT> input = {p_start, p_mid, p_end};
-          vector<POINT> b_modify = Bezier(0.01, input);
+          FrameVector<POINT> input = {p_start, p_mid, p_end};
+          FrameVector<POINT> b_modify;
+          Bezier<2>(0.01, input, b_modify);
           track.pointsEdgeRight.resize(0);
           for (size_t kk = 0; kk < b_modify.size(); ++kk) {
             track.pointsEdgeRight.emplace_back(b_modify[kk]);
@@ -416,8 +421,9 @@ public:
         POINT p_start(ROWSIMAGE - 50, COLSIMAGE - 1);
         POINT p_mid((ROWSIMAGE - 50 + rowBreakpointLeft) * 3 / 8,
                     COLSIMAGE / 2);
-        vector<POINT> input = {p_start, p_mid, p_end};
-        vector<POINT> b_modify = Bezier(0.01, input);
+        FrameVector<POINT> input = {p_start, p_mid, p_end};
+        FrameVector<POINT> b_modify;
+        Bezier<2>(0.01, input, b_modify);
         track.pointsEdgeRight.resize(0);
         track.pointsEdgeLeft.resize(0);
         for (size_t kk = 0; kk < b_modify.size(); ++kk) {
@@ -520,7 +526,7 @@ public:
    *
    * @param ringImage 需要叠加显示的图像
    */
-  void drawImage(Tracking track, Mat &ringImage) {
+  void drawImage(const Tracking &track, Mat &ringImage) {
     for (size_t i = 0; i < track.pointsEdgeLeft.size(); i++) {
       circle(ringImage,
              Point(track.pointsEdgeLeft[i].y, track.pointsEdgeLeft[i].x), 2,
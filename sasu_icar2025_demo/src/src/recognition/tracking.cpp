@@ -20,10 +20,17 @@
  *
  * @copyright Copyright (c) 2022
  *
+ * @note 增量搜索模式（incremental）：30fps下相邻帧的赛道边缘只移动几个像素，
+ *       每行只在上一帧同行边缘附近的窗口内搜索；窗口内边缘不唯一、色块内部不连通、
+ *       宽度突变或上一帧无该行数据时，该行回退为整行扫描。
+ *       窗口结果只取跟踪中的色块：窗口外另有色块（岔路/斑马线/车库）时与整行扫描的色块数不同
  */
 
 #include "../../include/common.hpp"
+#include "../../include/edges.hpp"
+#include "../../include/rowscan.hpp"
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <opencv2/highgui.hpp>
@@ -34,10 +41,10 @@ using namespace std;
 
 class Tracking {
 public:
-  vector<POINT> pointsEdgeLeft;     // 赛道左边缘点集
-  vector<POINT> pointsEdgeRight;    // 赛道右边缘点集
-  vector<POINT> widthBlock;         // 色块宽度=终-起（每行）
-  vector<POINT> spurroad;           // 保存岔路信息
+  EdgePoints pointsEdgeLeft;        // 赛道左边缘点集
+  EdgePoints pointsEdgeRight;       // 赛道右边缘点集
+  EdgePoints widthBlock;            // 色块宽度=终-起（每行）
+  EdgePoints spurroad;              // 保存岔路信息
   double stdevLeft;                 // 边缘斜率方差（左）
   double stdevRight;                // 边缘斜率方差（右）
   int validRowsLeft = 0;            // 边缘有效行数（左）
@@ -45,6 +52,9 @@ public:
   POINT garageEnable = POINT(0, 0); // 车库识别标志：（x=1/0，y=row)
   uint16_t rowCutUp = 10;           // 图像顶部切行
   uint16_t rowCutBottom = 10;       // 图像底部切行
+  bool incremental = false;         // 增量搜索使能：以上一帧边缘为种子窗口搜索
+  int searchWindow = 12;            // 增量搜索窗口半宽（像素）
+  int rowsFast = 0;                 // 本帧窗口搜索成功的行数
 
   /**
    * @brief 赛道线识别
@@ -58,6 +68,7 @@ public:
     int startBlock[30];                            // 色块起点（行）
     int endBlock[30];                              // 色块终点（行）
     int counterBlock = 0;                          // 色块计数器（行）
+    int indexBlocks[30];                           // 连通色块序号（行）
     POINT pointSpurroad;                           // 岔路坐标
     bool spurroadEnable = false;
 
@@ -75,6 +86,7 @@ public:
       validRowsRight = 0;         // 边缘有效行数（右）
       flagStartBlock = true;      // 搜索到色块起始行的标志（行）
       garageEnable = POINT(0, 0); // 车库识别标志初始化
+      rowsFast = 0;               // 窗口搜索行数
       rowStart = ROWSIMAGE - rowCutBottom; // 默认底部起始行
     } else {
       if (pointsEdgeLeft.size() > rowStart)
@@ -94,8 +106,15 @@ public:
     for (int row = rowStart; row > rowCutUp; row--) // 有效行：10~220
     {
       counterBlock = 0; // 色块计数器清空
+      // 增量搜索：上一帧边缘附近窗口内提取色块（首行及重复搜索仍整行扫描）
+      if (incremental && !isResearch && !flagStartBlock &&
+          imageType == ImageType::Binary &&
+          windowSearch(row, startBlock[0], endBlock[0])) {
+        counterBlock = 1;
+        rowsFast++;
+      }
       // 搜索色（block）块信息
-      if (imageType == ImageType::Rgb) // 输入RGB图像
+      else if (imageType == ImageType::Rgb) // 输入RGB图像
       {
         if (imagePath.at<Vec3b>(row, 1)[2] > 0) {
           startBlock[counterBlock] = 0;
@@ -119,29 +138,10 @@ public:
             endBlock[counterBlock++] = COLSIMAGE - 1;
         }
       }
-      if (imageType == ImageType::Binary) // 输入二值化图像
+      else if (imageType == ImageType::Binary) // 输入二值化图像：SIMD行色块提取
       {
-        if (imagePath.at<uchar>(row, 1) > 127) {
-          startBlock[counterBlock] = 0;
-        }
-        for (int col = 1; col < COLSIMAGE; col++) // 搜索出每行的所有色块
-        {
-          if (imagePath.at<uchar>(row, col) > 127 &&
-              imagePath.at<uchar>(row, col - 1) <= 127) {
-            startBlock[counterBlock] = col;
-          } else {
-            if (imagePath.at<uchar>(row, col) <= 127 &&
-                imagePath.at<uchar>(row, col - 1) > 127) {
-              endBlock[counterBlock++] = col;
-              if (counterBlock >= end(endBlock) - begin(endBlock))
-                break;
-            }
-          }
-        }
-        if (imagePath.at<uchar>(row, COLSIMAGE - 1) > 127) {
-          if (counterBlock < end(endBlock) - begin(endBlock) - 1)
-            endBlock[counterBlock++] = COLSIMAGE - 1;
-        }
+        counterBlock = rowBlocks(imagePath.ptr<uchar>(row), COLSIMAGE, startBlock,
+                                 endBlock, end(endBlock) - begin(endBlock));
       }
 
       int widthBlocks = endBlock[0] - startBlock[0]; // 色块宽度临时变量
@@ -187,9 +187,9 @@ public:
         //-------------------------------------------------<车库标识识别>-------------------------------------------------------------
         if (counterBlock > 5 && !garageEnable.x) {
           int widthThis = 0;        // 色块的宽度
-          vector<int> widthGarage;  // 当前行色块宽度集合
-          vector<int> centerGarage; // 当前行色块质心集合
-          vector<int> indexGarage;  // 当前行有效色块的序号
+          widthGarage.clear();  // 当前行色块宽度集合
+          centerGarage.clear(); // 当前行色块质心集合
+          indexGarage.clear();  // 当前行有效色块的序号
 
           for (int i = 0; i < counterBlock; i++) {
             widthThis = endBlock[i] - startBlock[i];        // 色块的宽度
@@ -201,7 +201,8 @@ public:
             }
           }
 
-          int widthMiddle = getMiddleValue(widthGarage); // 斑马线色块宽度中值
+          garageSort = widthGarage;
+          int widthMiddle = getMiddleValue(garageSort); // 斑马线色块宽度中值
 
           for (size_t i = 0; i < widthGarage.size(); i++) {
             if (abs(widthGarage[i] - widthMiddle) < widthMiddle / 3) {
@@ -210,13 +211,13 @@ public:
           }
           if (indexGarage.size() >= 4) // 验证有效斑马线色块个数
           {
-            vector<int> distance;
+            distanceGarage.clear();
             for (size_t i = 1; i < indexGarage.size(); i++) // 质心间距的方差校验
             {
-              distance.push_back(widthGarage[indexGarage[i]] -
-                                 widthGarage[indexGarage[i - 1]]);
+              distanceGarage.push_back(widthGarage[indexGarage[i]] -
+                                       widthGarage[indexGarage[i - 1]]);
             }
-            double var = sigma(distance);
+            double var = sigma(distanceGarage);
             if (var < 5.0) // 经验参数
             {
               garageEnable.x = 1;                      // 车库标志使能
@@ -226,22 +227,22 @@ public:
         }
         //------------------------------------------------------------------------------------------------------------------------
 
-        vector<int> indexBlocks;               // 色块序号（行）
+        int counterIndex = 0;                  // 连通色块数（行）
         for (int i = 0; i < counterBlock; i++) // 上下行色块的连通性判断
         {
           int g_cover =
               min(endBlock[i], pointsEdgeRight[pointsEdgeRight.size() - 1].y) -
               max(startBlock[i], pointsEdgeLeft[pointsEdgeLeft.size() - 1].y);
           if (g_cover >= 0) {
-            indexBlocks.push_back(i);
+            indexBlocks[counterIndex++] = i;
           }
         }
 
-        if (indexBlocks.size() ==
+        if (counterIndex ==
             0) // 如果没有发现联通色块，则图像搜索完成，结束任务
         {
           break;
-        } else if (indexBlocks.size() ==
+        } else if (counterIndex ==
                    1) // 只存在单个色块，正常情况，提取边缘信息
         {
           if (endBlock[indexBlocks[0]] - startBlock[indexBlocks[0]] <
@@ -255,7 +256,7 @@ public:
           widthBlock.emplace_back(row, endBlock[indexBlocks[0]] -
                                            startBlock[indexBlocks[0]]);
           spurroadEnable = false;
-        } else if (indexBlocks.size() >
+        } else if (counterIndex >
                    1) // 存在多个色块，则需要择优处理：选取与上一行最近的色块
         {
           int centerLast = COLSIMAGE / 2;
@@ -274,7 +275,7 @@ public:
           int endBlockNear =
               endBlock[indexBlocks[0]]; // 搜索与上一行最近的色块终点
 
-          for (size_t i = 1; i < indexBlocks.size();
+          for (int i = 1; i < counterIndex;
                i++) // 搜索与上一行最近的色块编号
           {
             centerThis =
@@ -350,6 +351,17 @@ public:
   void trackRecognition(Mat &imageBinary) {
     imagePath = imageBinary;
     trackRecognition(false, 0);
+
+    // 记录本帧各行边缘，作为下一帧增量搜索的种子
+    for (int row = 0; row < ROWSIMAGE; row++)
+      edgeLast[row][0] = edgeLast[row][1] = -1;
+    for (size_t i = 0; i < pointsEdgeLeft.size() && i < pointsEdgeRight.size(); i++) {
+      int row = pointsEdgeLeft[i].x;
+      if (row >= 0 && row < ROWSIMAGE) {
+        edgeLast[row][0] = pointsEdgeLeft[i].y;
+        edgeLast[row][1] = pointsEdgeRight[i].y;
+      }
+    }
   }
 
   /**
@@ -378,6 +390,9 @@ public:
     putText(trackImage, to_string(validRowsLeft) + " " + to_string(stdevLeft),
             Point(20, ROWSIMAGE - 50), FONT_HERSHEY_TRIPLEX, 0.3,
             Scalar(0, 0, 255), 1, CV_AA);
+    if (incremental)
+      putText(trackImage, "fast: " + to_string(rowsFast), Point(20, ROWSIMAGE - 35),
+              FONT_HERSHEY_TRIPLEX, 0.3, Scalar(0, 0, 255), 1, CV_AA);
   }
 
   /**
@@ -387,31 +402,95 @@ public:
    * @param img_height
    * @return double
    */
-  double stdevEdgeCal(vector<POINT> &v_edge, int img_height) {
+  double stdevEdgeCal(const EdgePoints &v_edge, int img_height) {
     if (v_edge.size() < static_cast<size_t>(img_height / 4)) {
       return 1000;
     }
-    vector<int> v_slope;
+    int v_slope[EDGE_CAPACITY / 10]; // 分段斜率（不超过点集容量/步长）
+    int counterSlope = 0;
     int step = 10; // v_edge.size()/10;
     for (size_t i = step; i < v_edge.size(); i += step) {
       if (v_edge[i].x - v_edge[i - step].x)
-        v_slope.push_back((v_edge[i].y - v_edge[i - step].y) * 100 /
-                          (v_edge[i].x - v_edge[i - step].x));
+        v_slope[counterSlope++] = (v_edge[i].y - v_edge[i - step].y) * 100 /
+                                  (v_edge[i].x - v_edge[i - step].x);
     }
-    if (v_slope.size() > 1) {
-      double sum = accumulate(begin(v_slope), end(v_slope), 0.0);
-      double mean = sum / v_slope.size(); // 均值
+    if (counterSlope > 1) {
+      double sum = accumulate(v_slope, v_slope + counterSlope, 0.0);
+      double mean = sum / counterSlope; // 均值
       double accum = 0.0;
-      for_each(begin(v_slope), end(v_slope),
+      for_each(v_slope, v_slope + counterSlope,
                [&](const double d) { accum += (d - mean) * (d - mean); });
 
-      return sqrt(accum / (v_slope.size() - 1)); // 方差
+      return sqrt(accum / (counterSlope - 1)); // 方差
     } else
       return 0;
   }
 
 private:
   Mat imagePath; // 赛道搜索图像
+  int edgeLast[ROWSIMAGE][2] = {}; // 上一帧各行左/右边缘（右<=左：无数据）
+  vector<int> widthGarage;         // 车库标识：色块宽度（复用内存）
+  vector<int> centerGarage;        // 车库标识：色块质心
+  vector<int> indexGarage;         // 车库标识：有效色块序号
+  vector<int> distanceGarage;      // 车库标识：宽度差
+  vector<int> garageSort;          // 车库标识：中值排序缓存
+
+  /**
+   * @brief 增量窗口搜索：在上一帧同行边缘附近寻找本行唯一的左右边缘
+   *
+   * @param row 行号
+   * @param left 左边缘（色块起点）
+   * @param right 右边缘（色块终点）
+   * @return false 置信度不足，需整行扫描
+   */
+  bool windowSearch(int row, int &left, int &right) {
+    const int lastLeft = edgeLast[row][0], lastRight = edgeLast[row][1];
+    if (lastLeft < 0 || lastRight <= lastLeft)
+      return false;
+
+    const uchar *pixels = imagePath.ptr<uchar>(row);
+    int counter = 0;
+
+    // 左边缘：窗口内唯一的上升沿；贴近图像左边界时允许起点为0（同整行扫描）
+    int low = max(1, lastLeft - searchWindow);
+    int high = min(COLSIMAGE - 1, lastLeft + searchWindow);
+    for (int col = low; col <= high; col++) {
+      if (pixels[col] > 127 && pixels[col - 1] <= 127) {
+        left = col;
+        counter++;
+      }
+    }
+    if (counter == 0 && low == 1 && pixels[1] > 127)
+      left = 0;
+    else if (counter != 1)
+      return false;
+
+    // 右边缘：窗口内唯一的下降沿；贴近图像右边界时允许终点为COLSIMAGE-1
+    counter = 0;
+    low = max(1, lastRight - searchWindow);
+    high = min(COLSIMAGE - 1, lastRight + searchWindow);
+    for (int col = low; col <= high; col++) {
+      if (pixels[col] <= 127 && pixels[col - 1] > 127) {
+        right = col;
+        counter++;
+      }
+    }
+    if (counter == 0 && high == COLSIMAGE - 1 && pixels[COLSIMAGE - 1] > 127)
+      right = COLSIMAGE - 1;
+    else if (counter != 1)
+      return false;
+
+    // 宽度突变：丢失色块或边缘跳变
+    if (right <= left ||
+        abs((right - left) - (lastRight - lastLeft)) > searchWindow)
+      return false;
+
+    // 色块内部连通（二值图像只含0/255）：内部出现黑色说明存在多个色块（岔路/斑马线）
+    if (memchr(pixels + left + 1, 0, right - left - 1) != nullptr)
+      return false;
+
+    return true;
+  }
   /**
    * @brief 赛道识别输入图像类型
    *
@@ -428,7 +507,7 @@ private:
    * @param edge
    * @param index
    */
-  void slopeCal(vector<POINT> &edge, int index) {
+  void slopeCal(EdgePoints &edge, int index) {
     if (index <= 4) {
       return;
     }
@@ -493,12 +572,12 @@ private:
   }
 
   /**
-   * @brief 冒泡法求取集合中值
+   * @brief 冒泡法求取集合中值（原地排序）
    *
    * @param vec 输入集合
    * @return int 中值
    */
-  int getMiddleValue(vector<int> vec) {
+  int getMiddleValue(vector<int> &vec) {
     if (vec.size() < 1)
       return -1;
     if (vec.size() == 1)
@@ -0,0 +1,248 @@
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file replay.cpp
+ * @author HC
+ * @brief 无界面确定性回放：完整决策流程离线跑视频，记录逐帧控制输出
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 用法：./replay [视频] [输出日志] [key=value...]  回放视频，逐帧记录控制输出与场景状态，输出吞吐率
+ *            ./replay compare [日志A] [日志B]             逐帧比对两份回放日志
+ *       参数覆盖：key=value覆盖config.json中同名参数，用于同一视频上对比两种配置的决策输出，例如
+ *            ./replay sample.mp4 a.bin trackIncremental=false && ./replay sample.mp4 b.bin trackIncremental=true
+ *            ./replay compare a.bin b.bin
+ *       默认：视频为config.json中video，日志为../res/samples/replay.bin
+ *       流程与icar顺序模式一致：[预处理] → [AI推理] → [赛道识别] → [场景检测] → [控制中心] → [运动控制]
+ *       不打开串口、不显示图像、不按帧率等待；控制指令由串口替身写入日志
+ *       AI推理后端取config.json中backend：配合replay后端（检测记录文件）时结果与车上运行逐帧一致
+ *       运动控制按非调试模式计算（忽略debug），前30帧为初始化（与车上一致，不输出控制量）
+ */
+#include "../include/common.hpp"    //公共类方法文件
+#include "../include/detection.hpp" //百度Paddle框架移动端部署
+#include "../include/heapaudit.hpp" //稳态堆分配审计
+#include "../include/profiler.hpp"  //分阶段耗时统计
+#include "decision.cpp"             //场景决策类
+#include "motion.cpp"               //智能车运动控制类
+#include "preprocess.cpp"           //图像预处理类
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+#define REPLAY_FILE_MAGIC "ICARRPL1" // 回放日志文件头
+
+/**
+ * @brief 回放日志单帧记录（16字节）
+ *
+ */
+struct ReplayRecord {
+  uint32_t seq = 0;           // 帧序号
+  float speed = 0;            // 速度：m/s
+  uint16_t servoPwm = 0;      // 舵机PWM
+  int16_t controlCenter = 0;  // 控制中心
+  uint16_t detections = 0;    // AI检测框数
+  uint8_t scene = 0;          // 场景状态
+  uint8_t flags = 0;          // bit0:运动控制使能 bit1:退出 bit2-3:检测音效 bit4-5:场景音效
+};
+static_assert(sizeof(ReplayRecord) == 16, "ReplayRecord must be packed to 16 bytes");
+
+/**
+ * @brief 串口替身：控制指令不下发，写入回放日志
+ *
+ */
+class UartSink {
+public:
+  UartSink(const string &path) : file(path, ios::binary) {
+    if (!file.is_open()) {
+      cout << "Error: cannot create replay log " << path << endl;
+      exit(-1);
+    }
+    file.write(REPLAY_FILE_MAGIC, 8);
+  }
+
+  /**
+   * @brief 执行控制指令（对应icar中的actuate）
+   *
+   * @return false 指令要求停车退出
+   */
+  bool actuate(const Command &cmd, int controlCenter, size_t detections) {
+    ReplayRecord record;
+    record.seq = cmd.seq;
+    record.speed = cmd.speed;
+    record.servoPwm = cmd.servoPwm;
+    record.controlCenter = controlCenter;
+    record.detections = detections;
+    record.scene = cmd.scene;
+    record.flags = cmd.control | cmd.exit << 1 | cmd.soundDetect << 2 | cmd.soundScene << 4;
+    file.write((const char *)&record, sizeof(record));
+    scenes[cmd.scene]++;
+    return !cmd.exit;
+  }
+
+  int scenes[Scene::StopScene + 1] = {0}; // 各场景帧数
+
+private:
+  ofstream file; // 回放日志
+};
+
+/**
+ * @brief 读取回放日志
+ *
+ */
+bool loadReplay(const string &path, vector<ReplayRecord> &records) {
+  ifstream file(path, ios::binary);
+  char magic[8] = {0};
+  if (!file.read(magic, sizeof(magic)) || string(magic, 8) != REPLAY_FILE_MAGIC) {
+    cout << "Error: invalid replay log " << path << endl;
+    return false;
+  }
+  ReplayRecord record;
+  while (file.read((char *)&record, sizeof(record)))
+    records.push_back(record);
+  return true;
+}
+
+/**
+ * @brief 比对模式：逐帧比较两份回放日志（速度按float逐位比较）
+ *
+ */
+int compareReplay(const string &pathA, const string &pathB) {
+  vector<ReplayRecord> a, b;
+  if (!loadReplay(pathA, a) || !loadReplay(pathB, b))
+    return -1;
+
+  size_t frames = min(a.size(), b.size()), mismatch = 0;
+  for (size_t i = 0; i < frames; i++) {
+    if (memcmp(&a[i], &b[i], sizeof(ReplayRecord)) == 0)
+      continue;
+    if (mismatch++ == 0)
+      printf("[compare] first mismatch: frame %u | scene %s/%s | speed %.3f/%.3f | pwm %u/%u | center %d/%d\n",
+             a[i].seq, getScene((Scene)a[i].scene).c_str(), getScene((Scene)b[i].scene).c_str(), a[i].speed,
+             b[i].speed, a[i].servoPwm, b[i].servoPwm, a[i].controlCenter, b[i].controlCenter);
+  }
+  printf("[compare] frames: %zu/%zu | mismatch: %zu\n", a.size(), b.size(), mismatch);
+  return mismatch || a.size() != b.size() ? -1 : 0;
+}
+
+int main(int argc, char const *argv[]) {
+  if (argc > 1 && string(argv[1]) == "compare") {
+    if (argc < 4) {
+      printf("usage: ./replay compare [log A] [log B]\n");
+      return -1;
+    }
+    return compareReplay(argv[2], argv[3]);
+  }
+
+  Preprocess preprocess; // 图像预处理类
+  Motion motion;         // 运动控制类
+  vector<string> args;   // 位置参数：[视频] [输出日志]
+  for (int i = 1; i < argc; i++) {
+    string arg = argv[i];
+    size_t eq = arg.find('=');
+    if (eq == string::npos) {
+      args.push_back(arg);
+      continue;
+    }
+    // 参数覆盖：key=value（value按JSON解析，解析失败按字符串处理）
+    nlohmann::json js = motion.params;
+    string key = arg.substr(0, eq), value = arg.substr(eq + 1);
+    if (!js.contains(key)) {
+      cout << "Error: unknown param " << key << endl;
+      return -1;
+    }
+    nlohmann::json parsed = nlohmann::json::parse(value, nullptr, false);
+    js[key] = parsed.is_discarded() ? nlohmann::json(value) : parsed;
+    motion.params = js.get<Motion::Params>();
+    cout << "[replay] " << key << " = " << js[key].dump() << endl;
+  }
+  Decision decision(motion);     // 场景决策类
+  motion.params.debug = false;   // 按非调试模式计算运动控制
+  motion.params.saveImg = false; // 不存图
+
+  string pathVideo = args.size() > 0 ? args[0] : motion.params.video;
+  string pathLog = args.size() > 1 ? args[1] : "../res/samples/replay.bin";
+
+  // 目标检测类(AI模型文件)
+  shared_ptr<Detection> detection = make_shared<Detection>(motion.params.model, motion.params.backend,
+                                                          motion.params.detectionFile, motion.params.recordDetection,
+                                                          motion.params.nativePost);
+  detection->score = motion.params.score; // AI检测置信度
+  detection->keyframeMax = motion.params.keyframeMax;     // AI关键帧最大间隔
+  detection->keyframeDecay = motion.params.keyframeDecay; // 传播帧置信度衰减
+
+  if (motion.params.profile) // 分阶段耗时统计：回放结束时输出
+    profiler.start(motion.params.profileFile, 0);
+  HeapAudit::mode = (HeapAudit::Mode)motion.params.heapAudit; // 稳态堆分配审计
+  HeapAudit::warmup = motion.params.heapAuditWarmup;
+
+  VideoCapture capture(pathVideo); // 本地视频
+  if (!capture.isOpened()) {
+    printf("can not open video: %s\n", pathVideo.c_str());
+    return -1;
+  }
+  UartSink uart(pathLog); // 串口替身
+
+  Mat img, imgCorrect, imgBinary;
+  uint64_t seq = 0;
+  auto start = chrono::steady_clock::now();
+  while (capture.read(img)) {
+    seq++;
+    if (img.cols != COLSIMAGE || img.rows != ROWSIMAGE)
+      resize(img, img, Size(COLSIMAGE, ROWSIMAGE));
+
+    //[02] 图像预处理
+    preprocess.process(img, imgCorrect, imgBinary); // 图像矫正+二值化
+
+    //[03] AI推理
+    detection->inference(imgCorrect);
+
+    Command cmd;
+    {
+      HeapAudit::Scope audit(seq);
+
+      //[04] 赛道识别
+      decision.trackRecognition(imgBinary);
+
+      //[05-16] 场景检测与运动控制
+      cmd = decision.process(imgBinary, detection->results);
+    }
+    FrameArena::local().reset(); // 单帧临时内存回收
+    cmd.seq = seq;
+
+    //[17] 执行：写入回放日志
+    if (!uart.actuate(cmd, decision.ctrlCenter.controlCenter, detection->results.size())) {
+      printf("[Replay] exit at frame %lu (%s)\n", (unsigned long)seq, getScene(cmd.scene).c_str());
+      break;
+    }
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  printf("[Replay] %s -> %s\n", pathVideo.c_str(), pathLog.c_str());
+  printf("[Replay] frames: %lu | time: %.2fs | %.1ffps\n", (unsigned long)seq, seconds, seq / seconds);
+  for (int scene = 0; scene <= Scene::StopScene; scene++)
+    if (uart.scenes[scene])
+      printf("[Replay] %-10s %d frames\n", getScene((Scene)scene).c_str(), uart.scenes[scene]);
+  FrameArena &arena = FrameArena::local();
+  printf("[Replay] arena peak: %zu bytes | overflows: %lu | leaks: %lu | heap audit: %u\n", arena.peak,
+         (unsigned long)arena.overflows, (unsigned long)arena.leaks, HeapAudit::count());
+  printf("[Replay] edge point overflows: %lu\n", (unsigned long)EdgePoints::overflows());
+  profiler.dump();
+
+  capture.release();
+  return 0;
+}
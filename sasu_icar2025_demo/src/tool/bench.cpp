@@ -0,0 +1,621 @@
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file bench.cpp
+ * @author HC
+ * @brief 图像算法性能基准测试
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 用法：./bench [项目] [样本数]
+ *                  ipm : 俯视图生成，两步法（镜头矫正remap + 逆透视remap）对比复合查找表（单次remap）
+ *                  rowscan : 赛道行色块提取，逐像素扫描对比SIMD位图跳变法（结果逐行校验）
+ *                  tensor : AI模型输入前处理，OpenCV逐步处理对比融合单次遍历（结果逐元素校验）
+ *                  hough : 近水平线段检测，全角度HoughLinesP+角度筛选对比窄带霍夫（全角度时逐条校验）
+ *                  bezier : 贝塞尔曲线，逐点阶乘/pow对比定阶基函数表（控制中心3阶/赛道补线2阶，结果逐点校验）
+ *                  suite : 黄金帧基准：赛道识别/环岛/十字/控制中心/贝塞尔/俯视图/各场景检测器逐帧耗时与内存分配，与基线比对
+ *                  baseline : 运行suite并保存为基线
+ *                  all : 全部项目（默认，不含baseline）
+ *       样本图像：../res/samples/train/[序号].jpg
+ *       黄金帧：样本图像经Preprocess生成的矫正图/二值化图（与车上同一预处理），场景检测器使用合成的触发类别检测框
+ *       基线文件：../res/samples/bench_baseline.txt（名称 均值ns 标准差ns 分配次数/帧）
+ *       suite每帧计时结束后回收单帧内存池（同车上帧循环），超出内存池上限的次数列为overflow（应为0）
+ */
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <opencv2/highgui.hpp>
+#include <opencv2/opencv.hpp>
+#include "../include/common.hpp"
+#include "../include/hough.hpp"
+#include "../include/rowscan.hpp"
+#include "../include/tensor.hpp"
+#include "../src/mapping.cpp"
+#include "../src/preprocess.cpp"
+#include "../src/decision.cpp"
+
+using namespace std;
+using namespace cv;
+
+#define BENCH_LOOPS 20                                     // 每个样本重复次数
+#define BENCH_BASELINE "../res/samples/bench_baseline.txt" // 基线文件
+#define BENCH_TOLERANCE 0.10                               // 基线比对：耗时劣化容差
+
+//--------------------------------------------[内存分配计数]--------------------------------------------
+static atomic<uint64_t> allocations{0}; // operator new调用次数
+
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+/**
+ * @brief 读取样本图像
+ *
+ * @param count 最大样本数
+ */
+vector<Mat> loadSamples(int count)
+{
+    vector<Mat> samples;
+    for (int i = 1; i < 6000 && (int)samples.size() < count; i++)
+    {
+        Mat img = imread("../res/samples/train/" + to_string(i) + ".jpg");
+        if (img.empty())
+            continue;
+        if (img.cols != COLSIMAGE || img.rows != ROWSIMAGE)
+            resize(img, img, Size(COLSIMAGE, ROWSIMAGE));
+        samples.push_back(img);
+    }
+    return samples;
+}
+
+/**
+ * @brief 计时：返回单次调用平均耗时（us）
+ *
+ * @param samples 样本图像
+ * @param func 被测函数
+ */
+double timing(const vector<Mat> &samples, const function<void(const Mat &)> &func)
+{
+    for (const Mat &img : samples) // 预热
+        func(img);
+
+    auto start = chrono::steady_clock::now();
+    for (int loop = 0; loop < BENCH_LOOPS; loop++)
+        for (const Mat &img : samples)
+            func(img);
+    auto end = chrono::steady_clock::now();
+    return chrono::duration_cast<chrono::nanoseconds>(end - start).count() / 1000.0 / (BENCH_LOOPS * samples.size());
+}
+
+/**
+ * @brief 打印对比结果
+ *
+ */
+void report(const string &name, double timeBase, double timeNew)
+{
+    printf("[%s] legacy: %.1fus | new: %.1fus | speedup: %.2fx\n", name.c_str(), timeBase, timeNew, timeBase / timeNew);
+}
+
+/**
+ * @brief 俯视图生成：两步法 vs 复合查找表
+ *
+ */
+void benchIpm(const vector<Mat> &samples)
+{
+    const string calibration = "../res/calibration/valid/calibration.xml";
+    Preprocess preprocess;
+    Mapping mapping(Size(COLSIMAGE, ROWSIMAGE), Size(COLSIMAGE, 400), calibration);
+
+    Mat imgCorrect, imgTwoStep, imgOneStep;
+    if (!mapping.homographyRaw(samples[0], imgOneStep))
+    {
+        cout << "[ipm] 缺少相机标定参数: " << calibration << endl;
+        return;
+    }
+
+    double timeBase = timing(samples, [&](const Mat &img)
+                             {
+        Mat frame = img;
+        imgCorrect = preprocess.correction(frame);
+        mapping.homography(imgCorrect, imgTwoStep); });
+    double timeNew = timing(samples, [&](const Mat &img)
+                            { mapping.homographyRaw(img, imgOneStep); });
+    report("ipm", timeBase, timeNew);
+
+    // 精度：两步法经过两次插值，与单次插值存在平滑差异
+    double diff = 0;
+    for (const Mat &img : samples)
+    {
+        Mat frame = img;
+        imgCorrect = preprocess.correction(frame);
+        mapping.homography(imgCorrect, imgTwoStep);
+        mapping.homographyRaw(img, imgOneStep);
+        Mat delta;
+        absdiff(imgTwoStep, imgOneStep, delta);
+        diff += mean(delta)[0];
+    }
+    printf("[ipm] mean abs diff: %.3f\n", diff / samples.size());
+}
+
+/**
+ * @brief 赛道行色块提取：逐像素扫描 vs SIMD位图跳变法
+ *
+ */
+void benchRowScan(const vector<Mat> &samples)
+{
+    Preprocess preprocess;
+    vector<Mat> binaries;
+    for (const Mat &img : samples)
+    {
+        Mat imgCorrect, imgBinary;
+        preprocess.process(img, imgCorrect, imgBinary);
+        binaries.push_back(imgBinary);
+    }
+
+    int startBlock[30], endBlock[30], counter = 0;
+    auto scan = [&](const Mat &img, int (*func)(const uint8_t *, int, int *, int *, int))
+    {
+        for (int row = ROWSIMAGE - 10; row > 10; row--) // 与Tracking默认切行一致
+            counter += func(img.ptr<uchar>(row), COLSIMAGE, startBlock, endBlock, 30);
+    };
+    double timeBase = timing(binaries, [&](const Mat &img)
+                             { scan(img, rowBlocksScalar); });
+    double timeNew = timing(binaries, [&](const Mat &img)
+                            { scan(img, rowBlocks); });
+    report("rowscan", timeBase, timeNew);
+
+    // 校验：逐行比较色块数与起点/终点
+    int mismatch = 0;
+    for (const Mat &img : binaries)
+    {
+        int start1[30] = {0}, end1[30] = {0}, start2[30] = {0}, end2[30] = {0};
+        for (int row = ROWSIMAGE - 1; row >= 0; row--)
+        {
+            int n1 = rowBlocksScalar(img.ptr<uchar>(row), COLSIMAGE, start1, end1, 30);
+            int n2 = rowBlocks(img.ptr<uchar>(row), COLSIMAGE, start2, end2, 30);
+            if (n1 != n2 || memcmp(start1, start2, sizeof(start1)) || memcmp(end1, end2, sizeof(end1)))
+                mismatch++;
+        }
+    }
+    printf("[rowscan] mismatch rows: %d | blocks: %d\n", mismatch, counter);
+}
+
+/**
+ * @brief AI模型输入前处理：OpenCV逐步处理 vs 融合单次遍历
+ *
+ */
+void benchTensor(const vector<Mat> &samples)
+{
+    const double mean[3] = {0.485, 0.456, 0.406};
+    const double stdev[3] = {0.229, 0.224, 0.225};
+    TensorInput input(Size(320, 320), mean, stdev);
+    vector<float> tensorLegacy(3 * 320 * 320), tensorFused(3 * 320 * 320);
+
+    double timeBase = timing(samples, [&](const Mat &img)
+                             { input.processLegacy(img, tensorLegacy.data()); });
+    double timeNew = timing(samples, [&](const Mat &img)
+                            { input.process(img, tensorFused.data()); });
+    report("tensor", timeBase, timeNew);
+
+    // 校验：逐元素比较（融合实现复现resize定点运算与归一化的float运算顺序）
+    double diff = 0;
+    size_t mismatch = 0;
+    for (const Mat &img : samples)
+    {
+        input.processLegacy(img, tensorLegacy.data());
+        input.process(img, tensorFused.data());
+        for (size_t i = 0; i < tensorFused.size(); i++)
+        {
+            double delta = fabs(tensorFused[i] - tensorLegacy[i]);
+            diff = max(diff, delta);
+            if (delta > 1e-6)
+                mismatch++;
+        }
+    }
+    printf("[tensor] max abs diff: %g | mismatch: %zu\n", diff, mismatch);
+}
+
+/**
+ * @brief 近水平线段检测：全角度HoughLinesP vs 窄带霍夫（参数同充电停车场入库转向）
+ *
+ */
+void benchHough(const vector<Mat> &samples)
+{
+    Preprocess preprocess;
+    vector<Mat> edges;
+    for (const Mat &img : samples)
+    {
+        Mat imgCorrect, imgBinary, imgEdges;
+        preprocess.process(img, imgCorrect, imgBinary);
+        Canny(imgBinary, imgEdges, 50, 150, 3);
+        edges.push_back(imgEdges);
+    }
+
+    HoughBand hough;
+    vector<Vec4i> linesLegacy, linesBand;
+    auto filter = [](const vector<Vec4i> &lines) // 同Parking：方向角(-40°, 0°)且位于右侧
+    {
+        int count = 0;
+        for (const Vec4i &line : lines)
+        {
+            double angle = atan2(line[3] - line[1], line[2] - line[0]) * 180.0 / CV_PI;
+            count += abs(angle) < 40 && angle < 0 && (line[0] + line[2]) / 2 > COLSIMAGE / 2;
+        }
+        return count;
+    };
+    double timeBase = timing(edges, [&](const Mat &img)
+                             { HoughLinesP(img, linesLegacy, 1, CV_PI / 180, 40, 40, 10); filter(linesLegacy); });
+    double timeNew = timing(edges, [&](const Mat &img)
+                            { hough.detect(img, linesBand, 1, CV_PI / 180, 40, 40, 10, -40, 0); filter(linesBand); });
+    report("hough", timeBase, timeNew);
+
+    // 校验：全角度范围逐条一致；限定范围后统计筛选结果
+    int mismatch = 0, countLegacy = 0, countBand = 0;
+    for (const Mat &img : edges)
+    {
+        HoughLinesP(img, linesLegacy, 1, CV_PI / 180, 40, 40, 10);
+        hough.detect(img, linesBand, 1, CV_PI / 180, 40, 40, 10, -90, 90);
+        if (linesLegacy.size() != linesBand.size() ||
+            !equal(linesLegacy.begin(), linesLegacy.end(), linesBand.begin(), [](const Vec4i &a, const Vec4i &b)
+                   { return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3]; }))
+            mismatch++;
+        countLegacy += filter(linesLegacy);
+        hough.detect(img, linesBand, 1, CV_PI / 180, 40, 40, 10, -40, 0);
+        countBand += filter(linesBand);
+    }
+    printf("[hough] full-range mismatch frames: %d | filtered lines legacy: %d | band: %d\n", mismatch, countLegacy, countBand);
+}
+
+/**
+ * @brief 贝塞尔曲线：逐点阶乘/pow vs 定阶基函数表（dt同控制中心拟合/障碍区/环岛补线）
+ *
+ */
+void benchBezier(const vector<Mat> &samples)
+{
+    // 控制点：各样本左边缘等分取点（同控制中心拟合）
+    Preprocess preprocess;
+    Tracking tracking;
+    vector<vector<POINT>> controls3, controls2;
+    for (const Mat &img : samples)
+    {
+        Mat imgCorrect, imgBinary;
+        preprocess.process(img, imgCorrect, imgBinary);
+        tracking.trackRecognition(imgBinary);
+        const EdgePoints &edge = tracking.pointsEdgeLeft;
+        vector<POINT> points3, points2;
+        if (edge.size() >= 4)
+        {
+            for (int k = 0; k < 4; k++)
+                points3.push_back(edge[k * (edge.size() - 1) / 3]);
+            for (int k = 0; k < 3; k++)
+                points2.push_back(edge[k * (edge.size() - 1) / 2]);
+        }
+        else
+        {
+            points3 = {POINT(ROWSIMAGE - 1, 20), POINT(160, 60), POINT(120, 100), POINT(60, 140)};
+            points2 = {POINT(ROWSIMAGE - 1, 20), POINT(140, 80), POINT(60, 140)};
+        }
+        controls3.push_back(points3);
+        controls2.push_back(points2);
+    }
+
+    const double dts[] = {0.01, 0.02, 0.03}; // 障碍区/控制中心/环岛补线
+    vector<POINT> curveLegacy, curveNew;
+    size_t index = 0; // timing按样本顺序调用
+    double timeBase = timing(samples, [&](const Mat &)
+                             {
+        const size_t i = index++ % samples.size();
+        for (double dt : dts)
+        {
+            curveLegacy = Bezier(dt, controls3[i]);
+            curveLegacy = Bezier(dt, controls2[i]);
+        } });
+    index = 0;
+    double timeNew = timing(samples, [&](const Mat &)
+                            {
+        const size_t i = index++ % samples.size();
+        for (double dt : dts)
+        {
+            Bezier<3>(dt, controls3[i], curveNew);
+            Bezier<2>(dt, controls2[i], curveNew);
+        } });
+    report("bezier", timeBase, timeNew);
+
+    // 校验：逐点比较（含dt过小时的逐点计算分支）
+    const double dtsCheck[] = {0.005, 0.01, 0.02, 0.03, 0.04, 0.05};
+    size_t mismatch = 0, points = 0;
+    auto check = [&](const vector<POINT> &a, const vector<POINT> &b)
+    {
+        points += a.size();
+        if (a.size() != b.size())
+            mismatch += max(a.size(), b.size());
+        else
+            for (size_t k = 0; k < a.size(); k++)
+                mismatch += a[k].x != b[k].x || a[k].y != b[k].y;
+    };
+    for (size_t i = 0; i < samples.size(); i++)
+        for (double dt : dtsCheck)
+        {
+            Bezier<3>(dt, controls3[i], curveNew);
+            check(Bezier(dt, controls3[i]), curveNew);
+            Bezier<2>(dt, controls2[i], curveNew);
+            check(Bezier(dt, controls2[i]), curveNew);
+        }
+    printf("[bezier] points: %zu | mismatch: %zu\n", points, mismatch);
+}
+
+/**
+ * @brief 黄金帧基准结果
+ *
+ */
+struct SuiteResult
+{
+    string name;        // 项目名称
+    double mean = 0;    // 平均耗时（ns/帧）
+    double stdev = 0;   // 耗时标准差（ns）
+    double allocs = 0;  // 内存分配次数/帧
+    uint64_t overflows = 0; // 单帧内存池超出上限次数（不写入基线）
+};
+
+/**
+ * @brief 黄金帧：样本图像的矫正图与二值化图
+ *
+ */
+struct GoldenFrames
+{
+    vector<Mat> corrects; // 矫正图像
+    vector<Mat> binaries; // 二值化图像
+};
+
+/**
+ * @brief 逐帧计时：每轮先reset()恢复初始状态，逐帧prepare(i)（不计时）后计时func(i)，
+ *        func(i)之后回收单帧内存池（不计时）
+ *
+ * @param frames 帧数
+ * @param reset 每轮开始前调用（场景状态机复位）
+ * @param prepare 每帧计时前调用（赛道识别等前置步骤）
+ * @param func 被测函数
+ */
+SuiteResult measure(const string &name, int frames, const function<void()> &reset,
+                    const function<void(int)> &prepare, const function<void(int)> &func)
+{
+    vector<double> times;
+    times.reserve(BENCH_LOOPS * frames);
+    uint64_t allocated = 0;
+    FrameArena &arena = FrameArena::local();
+    const uint64_t overflows = arena.overflows;
+    for (int loop = 0; loop <= BENCH_LOOPS; loop++) // 第0轮预热
+    {
+        reset();
+        for (int i = 0; i < frames; i++)
+        {
+            prepare(i);
+            const uint64_t count = allocations.load(memory_order_relaxed);
+            auto start = chrono::steady_clock::now();
+            func(i);
+            auto end = chrono::steady_clock::now();
+            arena.reset(); // 帧结束回收（同车上帧循环）
+            if (loop == 0)
+                continue;
+            allocated += allocations.load(memory_order_relaxed) - count;
+            times.push_back(chrono::duration<double, nano>(end - start).count());
+        }
+    }
+
+    SuiteResult result;
+    result.name = name;
+    for (double t : times)
+        result.mean += t;
+    result.mean /= times.size();
+    for (double t : times)
+        result.stdev += (t - result.mean) * (t - result.mean);
+    result.stdev = sqrt(result.stdev / times.size());
+    result.allocs = (double)allocated / times.size();
+    result.overflows = arena.overflows - overflows;
+    return result;
+}
+
+/**
+ * @brief 合成检测结果：每个触发类别一个检测框（赛道中部，高置信度）
+ *
+ * @param labels 类别标志集合
+ */
+PredictResults triggers(uint32_t labels)
+{
+    PredictResults results;
+    for (int type = 0; type < LABEL_CAPACITY; type++)
+        if (labels & PredictResults::bit(type))
+            results.push_back({type, 0.9f, COLSIMAGE / 2 - 30, ROWSIMAGE / 2, 60, 40});
+    results.build();
+    return results;
+}
+
+/**
+ * @brief 读取基线
+ *
+ */
+map<string, SuiteResult> loadBaseline(void)
+{
+    map<string, SuiteResult> baseline;
+    ifstream file(BENCH_BASELINE);
+    SuiteResult result;
+    while (file >> result.name >> result.mean >> result.stdev >> result.allocs)
+        baseline[result.name] = result;
+    return baseline;
+}
+
+/**
+ * @brief 黄金帧基准：赛道识别/环岛/十字/控制中心/贝塞尔/俯视图/各场景检测器
+ *
+ * @param save 保存为基线
+ * @return int 超出基线容差的项目数
+ */
+int benchSuite(const vector<Mat> &samples, bool save)
+{
+    Preprocess preprocess;
+    GoldenFrames golden;
+    for (const Mat &img : samples)
+    {
+        Mat imgCorrect, imgBinary;
+        preprocess.process(img, imgCorrect, imgBinary);
+        golden.corrects.push_back(imgCorrect);
+        golden.binaries.push_back(imgBinary);
+    }
+    const int frames = golden.binaries.size();
+
+    Tracking tracking;
+    LineFeatures features;
+    auto none = []() {};
+    auto track = [&](int i) // 前置：赛道识别（场景处理会修改边缘点，逐帧重新识别）
+    {
+        tracking.trackRecognition(golden.binaries[i]);
+        features.frame(golden.binaries[i]);
+    };
+
+    vector<SuiteResult> results;
+
+    // 赛道识别与路径规划
+    results.push_back(measure("tracking", frames, none, [](int) {}, [&](int i)
+                              { tracking.trackRecognition(golden.binaries[i]); }));
+    Ring ring;
+    results.push_back(measure("ring", frames, [&]() { ring = Ring(); }, track, [&](int i)
+                              { ring.process(tracking, golden.binaries[i]); }));
+    Crossroad crossroad;
+    results.push_back(measure("crossroad", frames, [&]() { crossroad = Crossroad(); }, track, [&](int)
+                              { crossroad.crossRecognition(tracking); }));
+    ControlCenter ctrlCenter;
+    results.push_back(measure("fitting", frames, none, track, [&](int)
+                              { ctrlCenter.fitting(tracking); }));
+
+    // 贝塞尔：左边缘等分取4个控制点（同十字/障碍区补线）
+    vector<POINT> controls, curve;
+    results.push_back(measure("bezier", frames, none, [&](int i)
+                              {
+        tracking.trackRecognition(golden.binaries[i]);
+        const EdgePoints &edge = tracking.pointsEdgeLeft;
+        controls.clear();
+        if (edge.size() >= 4)
+            for (int k = 0; k < 4; k++)
+                controls.push_back(edge[k * (edge.size() - 1) / 3]);
+        else
+            controls = {POINT(ROWSIMAGE - 1, 20), POINT(160, 60), POINT(120, 100), POINT(60, 140)}; }, [&](int)
+                              { Bezier<3>(0.02, controls, curve); }));
+
+    const string calibration = "../res/calibration/valid/calibration.xml";
+    Mapping mapping(Size(COLSIMAGE, ROWSIMAGE), Size(COLSIMAGE, 400), calibration);
+    Mat imgIpm;
+    results.push_back(measure("homography", frames, none, [](int) {}, [&](int i)
+                              { mapping.homography(golden.corrects[i], imgIpm); }));
+
+    // 场景检测器：每帧带触发类别
+    PredictResults predict;
+    StopArea stopArea;
+    predict = triggers(StopArea::LABELS);
+    results.push_back(measure("stop", frames, [&]() { stopArea = StopArea(); }, [](int) {}, [&](int)
+                              { stopArea.process(predict); }));
+    Catering catering;
+    PredictResults predictCatering = triggers(Catering::LABELS);
+    results.push_back(measure("catering", frames, [&]() { catering = Catering(); }, track, [&](int)
+                              { catering.process(tracking, features, predictCatering); }));
+    Layby layby;
+    PredictResults predictLayby = triggers(Layby::LABELS);
+    results.push_back(measure("layby", frames, [&]() { layby = Layby(); }, track, [&](int)
+                              { layby.process(tracking, features, predictLayby); }));
+    Parking parking;
+    PredictResults predictParking = triggers(Parking::LABELS);
+    results.push_back(measure("parking", frames, [&]() { parking = Parking(); }, track, [&](int)
+                              { parking.process(tracking, features, predictParking); }));
+    Bridge bridge;
+    PredictResults predictBridge = triggers(Bridge::LABELS);
+    results.push_back(measure("bridge", frames, [&]() { bridge = Bridge(); }, track, [&](int)
+                              { bridge.process(tracking, predictBridge); }));
+    Obstacle obstacle;
+    PredictResults predictObstacle = triggers(Obstacle::LABELS);
+    results.push_back(measure("obstacle", frames, [&]() { obstacle = Obstacle(); }, track, [&](int)
+                              { obstacle.process(tracking, predictObstacle); }));
+
+    // 输出并与基线比对
+    map<string, SuiteResult> baseline = loadBaseline();
+    int regressions = 0;
+    printf("[suite] %d golden frames x %d loops\n", frames, BENCH_LOOPS);
+    printf("%-12s %12s %12s %8s %10s %9s %12s %10s\n", "item", "mean(ns)", "stdev(ns)", "cv", "alloc", "overflow",
+           "vs base", "alloc +/-");
+    for (const SuiteResult &r : results)
+    {
+        printf("%-12s %12.0f %12.0f %7.1f%% %10.2f %9lu", r.name.c_str(), r.mean, r.stdev, 100 * r.stdev / r.mean, r.allocs,
+               (unsigned long)r.overflows);
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || save)
+        {
+            printf("\n");
+            continue;
+        }
+        const SuiteResult &b = it->second;
+        const double delta = r.mean / b.mean - 1;
+        const bool worse = delta > BENCH_TOLERANCE || r.allocs > b.allocs + 0.01 || r.overflows > 0;
+        regressions += worse;
+        printf(" %+11.1f%% %+10.2f%s\n", 100 * delta, r.allocs - b.allocs, worse ? "  <- regression" : "");
+    }
+
+    if (save)
+    {
+        ofstream file(BENCH_BASELINE);
+        for (const SuiteResult &r : results)
+            file << r.name << " " << r.mean << " " << r.stdev << " " << r.allocs << "\n";
+        printf("[suite] baseline saved: %s\n", BENCH_BASELINE);
+    }
+    else if (baseline.empty())
+        printf("[suite] no baseline: run ./bench baseline\n");
+    else
+        printf("[suite] regressions: %d (tolerance %.0f%%)\n", regressions, 100 * BENCH_TOLERANCE);
+    return regressions;
+}
+
+int main(int argc, char const *argv[])
+{
+    string item = argc > 1 ? argv[1] : "all";
+    int count = argc > 2 ? atoi(argv[2]) : 50;
+
+    vector<Mat> samples = loadSamples(count);
+    if (samples.empty())
+    {
+        cout << "未找到样本图像: ../res/samples/train/" << endl;
+        return -1;
+    }
+    printf("------------[Bench] %zu samples x %d loops------------\n", samples.size(), BENCH_LOOPS);
+
+    if (item == "ipm" || item == "all")
+        benchIpm(samples);
+    if (item == "rowscan" || item == "all")
+        benchRowScan(samples);
+    if (item == "tensor" || item == "all")
+        benchTensor(samples);
+    if (item == "hough" || item == "all")
+        benchHough(samples);
+    if (item == "bezier" || item == "all")
+        benchBezier(samples);
+    if (item == "suite" || item == "baseline" || item == "all")
+        return benchSuite(samples, item == "baseline") ? -1 : 0;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ ********************************************************************************************************
+ *                                               示例代码
+ *                                             EXAMPLE  CODE
+ *
+ *                      (c) Copyright 2025; SaiShu.Lcc.; HC; https://bjsstech.com
+ *                                   版权所属[SASU-北京赛曙科技有限公司]
+ *
+ *            The code is for internal use only, not for commercial transactions(开源学习,请勿商用).
+ *            The code ADAPTS the corresponding hardware circuit board(代码适配百度Edgeboard-智能汽车赛事版),
+ *            The specific details consult the professional(欢迎联系我们,代码持续更正，敬请关注相关开源渠道).
+ *********************************************************************************************************
+ * @file capture.cpp
+ * @author HC
+ * @brief 图像采集自检：V4L2零拷贝采集 / 本地视频替身 / 最新帧采集
+ * @version 0.1
+ * @date 2025-03-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note 用法：./capture [设备或视频] [帧数] [占用帧数]
+ *       默认：/dev/video0，300帧，占用3帧
+ *       虚拟摄像头：sudo modprobe vivid && ./capture /dev/video0（vivid设备号以v4l2-ctl --list-devices为准）
+ *       本地替身：./capture ../res/samples/sample.mp4（读到文件结束为止）
+ *       检查步骤：
+ *                  [01] 解码尺寸与设定分辨率（COLSIMAGE×ROWSIMAGE）一致
+ *                  [02] 时间戳单调递增，驱动帧序号不回退（跳变计为驱动丢帧）
+ *                  [03] 同时占用若干帧（不释放）继续采集：缓冲区释放后重新入队，采集不中断
+ *                  [04] 零拷贝：采集帧直接引用驱动缓冲区，不同缓冲区地址个数即驱动缓冲区个数
+ *                  [05] 最新帧采集：消费慢于帧率时只取最新帧，输出丢帧计数
+ *                  [06] 本地视频：文件结束后isOpened()返回false，读取立即返回（不空转）
+ */
+#include "../include/capture.hpp" // V4L2图像采集
+#include "../include/common.hpp"  // 公共方法
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <set>
+
+using namespace std;
+using namespace cv;
+
+int main(int argc, char const *argv[])
+{
+    string path = argc > 1 ? argv[1] : "/dev/video0";
+    int frames = argc > 2 ? atoi(argv[2]) : 300;
+    size_t hold = argc > 3 ? atoi(argv[3]) : 3;
+    const bool file = path.compare(0, 10, "/dev/video") != 0;
+
+    shared_ptr<Capture> capture = Capture::create(path, COLSIMAGE, ROWSIMAGE, 30);
+    if (!capture->isOpened())
+    {
+        cout << "can not open video device: " << path << endl;
+        return -1;
+    }
+
+    int errors = 0, count = 0;
+    uint64_t lost = 0, sequence = 0;
+    int64_t timestamp = 0;
+    set<const uchar *> buffers; // 采集帧引用的缓冲区地址
+    deque<CaptureFrame> leased; // 占用中的采集帧
+    Mat bgr;
+    auto start = chrono::steady_clock::now();
+    while (count < frames || file)
+    {
+        CaptureFrame frame;
+        if (!capture->read(frame))
+        {
+            if (!capture->isOpened()) //[06] 文件结束
+                break;
+            cout << "[capture] read failed" << endl;
+            errors++;
+            if (errors > 10)
+                break;
+            continue;
+        }
+
+        //[01] 解码尺寸
+        if (!frame.decode(bgr) || bgr.cols != COLSIMAGE || bgr.rows != ROWSIMAGE)
+        {
+            printf("[capture] frame %d: decode %dx%d (expected %dx%d)\n", count, bgr.cols, bgr.rows, COLSIMAGE, ROWSIMAGE);
+            errors++;
+        }
+
+        //[02] 时间戳与帧序号
+        if (count > 0)
+        {
+            if (frame.timestamp <= timestamp)
+            {
+                printf("[capture] frame %d: timestamp not increasing\n", count);
+                errors++;
+            }
+            if (frame.sequence <= sequence)
+            {
+                printf("[capture] frame %d: sequence %lu after %lu\n", count, (unsigned long)frame.sequence,
+                       (unsigned long)sequence);
+                errors++;
+            }
+            else
+                lost += frame.sequence - sequence - 1;
+        }
+        timestamp = frame.timestamp;
+        sequence = frame.sequence;
+        buffers.insert(frame.data.data);
+
+        //[03] 占用若干帧：最早的帧释放后其缓冲区重新入队
+        leased.push_back(frame);
+        if (leased.size() > hold)
+            leased.pop_front();
+        count++;
+    }
+    leased.clear();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("[capture] %s | %d frames | %.1ffps | driver lost: %lu\n", path.c_str(), count, count / seconds,
+           (unsigned long)lost);
+    if (!file) //[04] 零拷贝：地址个数不超过驱动缓冲区个数
+        printf("[capture] distinct buffers: %zu (held %zu at a time)\n", buffers.size(), hold);
+    if (file)
+    {
+        CaptureFrame frame;
+        auto t0 = chrono::steady_clock::now();
+        bool again = capture->read(frame);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        printf("[capture] after end of file: read %s in %.2fms | isOpened %d\n", again ? "ok" : "failed", ms,
+               capture->isOpened());
+        errors += again || capture->isOpened();
+    }
+    capture->release();
+
+    //[05] 最新帧采集：每帧处理耗时约2个帧周期
+    if (!file)
+    {
+        CaptureLatest latest(Capture::create(path, COLSIMAGE, ROWSIMAGE, 30));
+        CaptureFrame frame;
+        int read = 0;
+        for (int i = 0; i < 60 && latest.isOpened(); i++)
+        {
+            if (!latest.read(frame))
+                continue;
+            read++;
+            frame.release();
+            this_thread::sleep_for(chrono::milliseconds(66));
+        }
+        printf("[capture] latest: read %d | captured %lu | dropped %lu\n", read, (unsigned long)latest.captured(),
+               (unsigned long)latest.dropped());
+        errors += read == 0 || latest.dropped() == 0;
+        latest.release();
+    }
+
+    printf("[capture] %s (%d errors)\n", errors ? "FAILED" : "OK", errors);
+    return errors ? -1 : 0;
+}
@@ -17,12 +17,13 @@
  * @date 2024-01-09
  * @copyright Copyright (c) 2024
  * @note 采图步骤：
- *                  [01] 启动OpenCV摄像头图像捕获
+ *                  [01] 启动V4L2摄像头图像捕获（零拷贝）
  *                  [02] 创建遥控手柄多线程任务
  *                  [03] 车速度与方向控制
  *                  [04] 图像显示与存储
  */
 #include "../include/uart.hpp"   // 串口通信
+#include "../include/capture.hpp" // V4L2图像采集
 #include "../include/common.hpp" // 公共方法
 #include <opencv2/opencv.hpp>    // OpenCV终端部署
 #include <opencv2/highgui.hpp>   //
@@ -232,15 +233,13 @@ int main(int argc, char const *argv[])
         return -1;
     }
 
-    // 摄像头初始化
-    VideoCapture capture("/dev/video0");
-    if (!capture.isOpened())
+    // 摄像头初始化（参数为视频文件路径时使用本地替身）
+    shared_ptr<Capture> capture = Capture::create(argc > 1 ? argv[1] : "/dev/video0", COLSIMAGE, ROWSIMAGE, 30);
+    if (!capture->isOpened())
     {
         std::cout << "can not open video device " << std::endl;
         return 1;
     }
-    capture.set(CAP_PROP_FRAME_WIDTH, COLSIMAGE);  // 设置图像的列
-    capture.set(CAP_PROP_FRAME_HEIGHT, ROWSIMAGE); // 设置图像的行
 
     // 创建遥控器多线程任务
     Joystick joy; // 遥控手柄类
@@ -259,9 +258,15 @@ int main(int argc, char const *argv[])
         }
 
         // 读取图像
-        Mat frame;
-        if (!capture.read(frame))
+        static CaptureFrame raw;
+        static Mat frame;
+        if (!capture->read(raw) || !raw.decode(frame))
+        {
+            if (!capture->isOpened()) // 视频文件结束
+                break;
             continue;
+        }
+        raw.release(); // 缓冲区归还驱动
 
         // 图像采集
         static int index = 0;
@@ -296,8 +301,9 @@ int main(int argc, char const *argv[])
         waitKey(10);
     }
 
-    joy.close();   // 退出子线程
-    uart->close(); // 串口通信关闭
+    joy.close();        // 退出子线程
+    uart->close();      // 串口通信关闭
+    capture->release(); // 摄像头关闭
 
     return 0;
 }
\ No newline at end of file